@@ -0,0 +1,199 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/action_list.hpp
+ *
+ * This header contains definition of \c action_list function object, which allows
+ * a single scope guard to invoke multiple actions.
+ */
+
+#ifndef BOOST_SCOPE_ACTION_LIST_HPP_INCLUDED_
+#define BOOST_SCOPE_ACTION_LIST_HPP_INCLUDED_
+
+#include <cstddef>
+#include <type_traits>
+#include <boost/scope/is_trivially_relocatable.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/compact_storage.hpp>
+#include <boost/scope/detail/type_traits/conjunction.hpp>
+#include <boost/scope/detail/type_traits/is_invocable.hpp>
+#include <boost/scope/detail/type_traits/is_nothrow_invocable.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+//! \cond
+namespace detail {
+
+//! Storage of the action list elements, starting from index \a I
+template< std::size_t I, typename... Funcs >
+class action_list_storage;
+
+template< std::size_t I >
+class action_list_storage< I >
+{
+public:
+    constexpr action_list_storage() noexcept = default;
+
+    void invoke() noexcept
+    {
+    }
+};
+
+template< std::size_t I, typename Func, typename... Rest >
+class action_list_storage< I, Func, Rest... > :
+    private compact_storage< Func, std::integral_constant< std::size_t, I > >,
+    private action_list_storage< I + 1u, Rest... >
+{
+private:
+    using func_base = compact_storage< Func, std::integral_constant< std::size_t, I > >;
+    using rest_base = action_list_storage< I + 1u, Rest... >;
+
+public:
+    template< typename F, typename... Args >
+    constexpr action_list_storage(F&& func, Args&&... rest)
+        noexcept(conjunction< std::is_nothrow_constructible< func_base, F >, std::is_nothrow_constructible< rest_base, Args... > >::value) :
+        func_base(static_cast< F&& >(func)),
+        rest_base(static_cast< Args&& >(rest)...)
+    {
+    }
+
+    //! Invokes the actions in the reverse order
+    void invoke() noexcept(conjunction< is_nothrow_invocable< Func& >, is_nothrow_invocable< Rest& >... >::value)
+    {
+        rest_base::invoke();
+        func_base::get()();
+    }
+};
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief A function object that invokes a list of actions in the reverse order.
+ *
+ * The action list is intended to be used as the action function object of a scope guard, such as
+ * \c scope_exit, \c scope_success or \c scope_fail, when there are multiple actions to be performed
+ * on scope exit. Compared to using multiple scope guards, the actions share a single condition
+ * function object and a single active flag, which allows to deactivate all of them at once.
+ *
+ * ```
+ * boost::scope::scope_fail guard(boost::scope::make_action_list(
+ *     [&] { undo_step1(); },
+ *     [&] { undo_step2(); }));
+ * ```
+ *
+ * When called, the action list invokes the actions in the reverse order of their specification, similar
+ * to the order of destruction of multiple scope guards. If an action throws an exception, the remaining
+ * actions are not invoked.
+ *
+ * The action list does not add storage overhead to the actions. Empty actions, such as lambda functions
+ * without captures, do not take space in the action list, where supported by the compiler.
+ *
+ * \tparam Funcs Action function object types. Each action must be callable with no arguments.
+ */
+template< typename... Funcs >
+class BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(detail::conjunction< is_trivially_relocatable< Funcs >... >::value)
+action_list :
+    private detail::action_list_storage< 0u, Funcs... >
+{
+    static_assert(detail::conjunction< detail::is_invocable< Funcs& >... >::value, "Boost.Scope: action_list actions must be callable with no arguments");
+
+//! \cond
+private:
+    using storage_base = detail::action_list_storage< 0u, Funcs... >;
+
+//! \endcond
+public:
+    //! Action result type
+    using result_type = void;
+
+public:
+    /*!
+     * \brief Constructs the action list.
+     *
+     * **Requires:** \c sizeof...(Args) is equal to \c sizeof...(Funcs) and each action type is constructible
+     *               from the corresponding argument.
+     *
+     * **Effects:** Constructs each action from the corresponding argument, as if by `std::forward< Args >(args)`.
+     *
+     * **Throws:** Nothing, unless construction of the actions throws.
+     *
+     * \param args Arguments for constructing the actions.
+     */
+    template<
+        typename... Args
+        //! \cond
+        , typename = typename std::enable_if< sizeof...(Args) == sizeof...(Funcs) && sizeof...(Args) != 0u >::type
+        , typename = typename std::enable_if< detail::conjunction< std::is_constructible< Funcs, Args >... >::value >::type
+        //! \endcond
+    >
+    constexpr explicit action_list(Args&&... args)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_constructible< storage_base, Args... >::value)) :
+        storage_base(static_cast< Args&& >(args)...)
+    {
+    }
+
+    action_list(action_list&&) = default;
+    action_list& operator= (action_list&&) = default;
+
+    action_list(action_list const&) = default;
+    action_list& operator= (action_list const&) = default;
+
+    /*!
+     * \brief Invokes the actions in the reverse order of their specification.
+     *
+     * **Throws:** Nothing, unless invoking the actions throws.
+     */
+    result_type operator() ()
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::conjunction< detail::is_nothrow_invocable< Funcs& >... >::value))
+    {
+        storage_base::invoke();
+    }
+};
+
+//! \cond
+template< typename... Funcs >
+struct is_trivially_relocatable< action_list< Funcs... > > :
+    public detail::conjunction< is_trivially_relocatable< Funcs >... >::type
+{
+};
+//! \endcond
+
+#if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
+template< typename... Funcs >
+action_list(Funcs...) -> action_list< Funcs... >;
+#endif // !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
+
+/*!
+ * \brief Creates an action list.
+ *
+ * **Effects:** Constructs an action list from `std::forward< Funcs >(funcs)...`.
+ *
+ * **Throws:** Nothing, unless construction of the actions throws.
+ *
+ * \param funcs Action function objects.
+ */
+template< typename... Funcs >
+inline action_list< typename std::decay< Funcs >::type... > make_action_list(Funcs&&... funcs)
+    noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_constructible< action_list< typename std::decay< Funcs >::type... >, Funcs... >::value))
+{
+    return action_list< typename std::decay< Funcs >::type... >(static_cast< Funcs&& >(funcs)...);
+}
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_ACTION_LIST_HPP_INCLUDED_
@@ -0,0 +1,200 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/arena_scope.hpp
+ *
+ * This header contains definition of \c arena_scope scope guard and \c arena_deleter
+ * deleter for monotonic memory arenas.
+ */
+
+#ifndef BOOST_SCOPE_ARENA_SCOPE_HPP_INCLUDED_
+#define BOOST_SCOPE_ARENA_SCOPE_HPP_INCLUDED_
+
+#include <utility>
+#include <type_traits>
+#include <boost/core/addressof.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/is_trivially_relocatable.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief Arena traits.
+ *
+ * The traits describe how to capture the current allocation position of a monotonic (bump) memory
+ * arena and how to rewind the arena to a previously captured position, freeing all memory allocated
+ * after it. By default, the traits require the arena to have the following public members:
+ *
+ * \li `M mark()` - returns the current allocation position, where \c M is a copyable marker type,
+ * \li `void rewind(M marker) noexcept` - frees all memory allocated after \c marker was obtained.
+ *
+ * Users may specialize the traits for arena types that have a different interface.
+ */
+template< typename Arena >
+struct arena_traits
+{
+    //! Arena position marker type
+    using marker_type = typename std::decay< decltype(std::declval< Arena& >().mark()) >::type;
+
+    //! Returns the current allocation position of the arena
+    static marker_type mark(Arena& arena) noexcept(noexcept(std::declval< Arena& >().mark()))
+    {
+        return arena.mark();
+    }
+
+    //! Rewinds the arena to the given allocation position
+    static void rewind(Arena& arena, marker_type const& marker) noexcept
+    {
+        arena.rewind(marker);
+    }
+};
+
+//! \cond
+namespace detail {
+
+//! Scope guard action that rewinds an arena
+template< typename Arena >
+class arena_rewind_action
+{
+public:
+    using marker_type = typename arena_traits< Arena >::marker_type;
+
+private:
+    Arena* m_arena;
+    marker_type m_marker;
+
+public:
+    explicit arena_rewind_action(Arena& arena) noexcept(noexcept(arena_traits< Arena >::mark(arena))) :
+        m_arena(boost::addressof(arena)),
+        m_marker(arena_traits< Arena >::mark(arena))
+    {
+    }
+
+    void operator() () const noexcept
+    {
+        arena_traits< Arena >::rewind(*m_arena, m_marker);
+    }
+};
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Scope guard that rewinds a monotonic memory arena on scope exit.
+ *
+ * On construction, the scope guard captures the current allocation position of the arena. On destruction,
+ * if the scope guard is active, it rewinds the arena to that position, which frees all memory allocated
+ * from the arena within the scope. The arena is rewound regardless of whether the scope is left normally
+ * or due to an exception.
+ *
+ * Objects allocated from the arena are not destroyed when the arena is rewound. The user is responsible
+ * for destroying objects with non-trivial destructors before leaving the scope.
+ *
+ * The arena is accessed through \c arena_traits. The arena must outlive the scope guard.
+ *
+ * \tparam Arena Arena type.
+ */
+template< typename Arena >
+class BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(is_trivially_relocatable< typename arena_traits< Arena >::marker_type >::value)
+arena_scope :
+    public scope_exit< detail::arena_rewind_action< Arena > >
+{
+//! \cond
+private:
+    using base_type = scope_exit< detail::arena_rewind_action< Arena > >;
+
+//! \endcond
+public:
+    //! Arena type
+    using arena_type = Arena;
+    //! Arena position marker type
+    using marker_type = typename arena_traits< Arena >::marker_type;
+
+public:
+    /*!
+     * \brief Captures the current allocation position of the arena.
+     *
+     * **Throws:** Nothing, unless capturing the allocation position or copying the marker throws.
+     *
+     * \param arena Arena to rewind on scope exit.
+     * \param active Indicates whether the scope guard should be active upon construction.
+     *
+     * \post `this->active() == active`
+     */
+    explicit arena_scope(Arena& arena, bool active = true)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_constructible< base_type, detail::arena_rewind_action< Arena >, bool >::value &&
+            noexcept(arena_traits< Arena >::mark(arena)))) :
+        base_type(detail::arena_rewind_action< Arena >(arena), active)
+    {
+    }
+
+    /*!
+     * \brief Move-constructs a scope guard.
+     *
+     * **Effects:** If \a that is active, the constructed scope guard becomes responsible for rewinding
+     *              the arena and \a that becomes inactive. Otherwise, the constructed scope guard is inactive.
+     *
+     * **Throws:** Nothing, unless copying the marker throws.
+     *
+     * \param that Move source.
+     */
+    arena_scope(arena_scope&& that) = default;
+
+    arena_scope& operator= (arena_scope&&) = delete;
+    arena_scope(arena_scope const&) = delete;
+    arena_scope& operator= (arena_scope const&) = delete;
+};
+
+//! \cond
+template< typename Arena >
+struct is_trivially_relocatable< arena_scope< Arena > > :
+    public is_trivially_relocatable< typename arena_traits< Arena >::marker_type >::type
+{
+};
+//! \endcond
+
+#if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
+template< typename Arena >
+arena_scope(Arena&) -> arena_scope< Arena >;
+template< typename Arena >
+arena_scope(Arena&, bool) -> arena_scope< Arena >;
+#endif // !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
+
+/*!
+ * \brief Deleter for objects allocated from a monotonic memory arena.
+ *
+ * The deleter does nothing. It is intended to be used with \c unique_resource that owns
+ * objects allocated from an arena, which is rewound with \c arena_scope. The memory is
+ * freed in bulk when the arena is rewound, and the objects are not destroyed. Therefore
+ * the deleter should only be used with trivially destructible objects.
+ */
+struct arena_deleter
+{
+    //! Deleter result type
+    using result_type = void;
+
+    //! Does nothing
+    template< typename T >
+    void operator() (T const&) const noexcept
+    {
+    }
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_ARENA_SCOPE_HPP_INCLUDED_
@@ -16,6 +16,8 @@
 
 #include <type_traits>
 #include <boost/scope/detail/config.hpp>
+#include <boost/scope/defer_macro.hpp>
+#include <boost/scope/is_trivially_relocatable.hpp>
 #include <boost/scope/detail/is_not_like.hpp>
 #include <boost/scope/detail/move_or_copy_construct_ref.hpp>
 #include <boost/scope/detail/type_traits/conjunction.hpp>
@@ -54,7 +56,8 @@ using is_not_like_defer_guard = detail::is_not_like< T, defer_guard >;
  * on destruction.
  */
 template< typename Func >
-class defer_guard
+class BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(is_trivially_relocatable< Func >::value)
+defer_guard
 {
 //! \cond
 private:
@@ -69,14 +72,16 @@ private:
         }
 
         template< typename F, typename = typename std::enable_if< std::is_constructible< Func, F >::value >::type >
-        explicit data(F&& func, std::false_type) try :
+        explicit data(F&& func, std::false_type) BOOST_SCOPE_DETAIL_FUNCTION_TRY :
             m_func(static_cast< F&& >(func))
         {
         }
+#if !defined(BOOST_NO_EXCEPTIONS)
         catch (...)
         {
             func();
         }
+#endif
     };
 
     data m_data;
@@ -140,39 +145,20 @@ public:
     }
 };
 
+//! \cond
+template< typename Func >
+struct is_trivially_relocatable< defer_guard< Func > > :
+    public is_trivially_relocatable< Func >::type
+{
+};
+//! \endcond
+
 #if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
 template< typename Func >
 defer_guard(Func) -> defer_guard< Func >;
 #endif // !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
 
 } // namespace scope
-
-//! \cond
-#if defined(BOOST_MSVC)
-#define BOOST_SCOPE_DETAIL_UNIQUE_VAR_TAG __COUNTER__
-#else
-#define BOOST_SCOPE_DETAIL_UNIQUE_VAR_TAG __LINE__
-#endif
-//! \endcond
-
-/*!
- * \brief The macro creates a uniquely named defer guard.
- *
- * The macro should be followed by a function object that should be called
- * on leaving the current scope. Usage example:
- *
- * ```
- * BOOST_SCOPE_DEFER []
- * {
- *     std::cout << "Hello world!" << std::endl;
- * };
- * ```
- *
- * \note Using this macro requires C++17.
- */
-#define BOOST_SCOPE_DEFER \
-    boost::scope::defer_guard BOOST_JOIN(_boost_defer_guard_, BOOST_SCOPE_DETAIL_UNIQUE_VAR_TAG) =
-
 } // namespace boost
 
 #include <boost/scope/detail/footer.hpp>
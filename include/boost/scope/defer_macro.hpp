@@ -0,0 +1,54 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2022-2024 Andrey Semashev
+ */
+/*!
+ * \file scope/defer_macro.hpp
+ *
+ * This header contains definition of \c BOOST_SCOPE_DEFER macro.
+ *
+ * The header only defines the macro and does not define \c defer_guard. It is
+ * intended to be used along with importing the `boost.scope` C++20 module,
+ * as macros cannot be exported from modules. When not using modules, include
+ * `boost/scope/defer.hpp` instead.
+ */
+
+#ifndef BOOST_SCOPE_DEFER_MACRO_HPP_INCLUDED_
+#define BOOST_SCOPE_DEFER_MACRO_HPP_INCLUDED_
+
+#include <boost/scope/detail/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+//! \cond
+#if defined(BOOST_MSVC)
+#define BOOST_SCOPE_DETAIL_UNIQUE_VAR_TAG __COUNTER__
+#else
+#define BOOST_SCOPE_DETAIL_UNIQUE_VAR_TAG __LINE__
+#endif
+//! \endcond
+
+/*!
+ * \brief The macro creates a uniquely named defer guard.
+ *
+ * The macro should be followed by a function object that should be called
+ * on leaving the current scope. Usage example:
+ *
+ * ```
+ * BOOST_SCOPE_DEFER []
+ * {
+ *     std::cout << "Hello world!" << std::endl;
+ * };
+ * ```
+ *
+ * \note Using this macro requires C++17.
+ */
+#define BOOST_SCOPE_DEFER \
+    boost::scope::defer_guard BOOST_JOIN(_boost_defer_guard_, BOOST_SCOPE_DETAIL_UNIQUE_VAR_TAG) =
+
+#endif // BOOST_SCOPE_DEFER_MACRO_HPP_INCLUDED_
@@ -0,0 +1,69 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/detail/cold_action.hpp
+ *
+ * This header contains definition of tools for invoking scope guard actions
+ * on a cold code path.
+ */
+
+#ifndef BOOST_SCOPE_DETAIL_COLD_ACTION_HPP_INCLUDED_
+#define BOOST_SCOPE_DETAIL_COLD_ACTION_HPP_INCLUDED_
+
+#include <type_traits>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/type_traits/is_nothrow_invocable.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BOOST_SCOPE_DETAIL_COLD __attribute__((cold))
+#else
+#define BOOST_SCOPE_DETAIL_COLD
+#endif
+
+namespace boost {
+namespace scope {
+namespace detail {
+
+/*!
+ * The type trait indicates whether the scope guard condition function object detects a failure,
+ * which is expected to be unlikely. Scope guards with such conditions invoke their actions
+ * through a non-inlined cold function, unless \c BOOST_SCOPE_DISABLE_COLD_ACTIONS is defined.
+ */
+template< typename Cond >
+struct is_failure_condition : public std::false_type { };
+
+//! The type trait indicates whether the scope guard action should be invoked on a cold code path
+template< typename Cond >
+struct is_cold_action_condition :
+#if !defined(BOOST_SCOPE_DISABLE_COLD_ACTIONS)
+    public is_failure_condition< Cond >::type
+#else
+    public std::false_type
+#endif
+{
+};
+
+//! Invokes the scope guard action. The function is not inlined and is marked as cold to move it out of the hot path.
+template< typename Func >
+BOOST_NOINLINE BOOST_SCOPE_DETAIL_COLD void invoke_cold_action(Func& func) noexcept(detail::is_nothrow_invocable< Func& >::value)
+{
+    func();
+}
+
+} // namespace detail
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_DETAIL_COLD_ACTION_HPP_INCLUDED_
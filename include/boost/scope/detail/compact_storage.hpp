@@ -67,7 +67,8 @@ template< typename T, typename Tag >
 class compact_storage< T, Tag, false >
 {
 private:
-    T m_data;
+    // Allows final classes to not take space, when supported by the compiler
+    BOOST_SCOPE_DETAIL_NO_UNIQUE_ADDRESS T m_data;
 
 public:
     template< typename... Args >
@@ -25,6 +25,24 @@
 #define BOOST_SCOPE_NO_CXX17_NOEXCEPT_FUNCTION_TYPES
 #endif
 
+#if defined(BOOST_MSVC) && (BOOST_MSVC >= 1929) && (BOOST_CXX_VERSION >= 202002l)
+// MSVC ignores the standard [[no_unique_address]] attribute for ABI compatibility reasons
+#define BOOST_SCOPE_DETAIL_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define BOOST_SCOPE_DETAIL_NO_UNIQUE_ADDRESS BOOST_ATTRIBUTE_NO_UNIQUE_ADDRESS
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && (__cpp_impl_three_way_comparison >= 201907l) && \
+    defined(__cpp_concepts) && (__cpp_concepts >= 201907l) && !defined(BOOST_NO_CXX20_HDR_COMPARE)
+#define BOOST_SCOPE_DETAIL_HAS_THREE_WAY_COMPARISON
+#endif
+
+#if !defined(BOOST_NO_EXCEPTIONS)
+#define BOOST_SCOPE_DETAIL_FUNCTION_TRY try
+#else
+#define BOOST_SCOPE_DETAIL_FUNCTION_TRY
+#endif
+
 #if !defined(BOOST_SCOPE_DETAIL_DOC_ALT)
 #if !defined(BOOST_SCOPE_DOXYGEN)
 #define BOOST_SCOPE_DETAIL_DOC_ALT(alt, ...) __VA_ARGS__
@@ -0,0 +1,127 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/detail/resource_instrumentation.hpp
+ *
+ * This header contains definition of \c resource_instrumentation type trait
+ * that extracts the instrumentation type from \c unique_resource resource traits.
+ */
+
+#ifndef BOOST_SCOPE_DETAIL_RESOURCE_INSTRUMENTATION_HPP_INCLUDED_
+#define BOOST_SCOPE_DETAIL_RESOURCE_INSTRUMENTATION_HPP_INCLUDED_
+
+#include <type_traits>
+#include <boost/scope/resource_site.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+namespace detail {
+
+//! Instrumentation that does nothing. Used when resource traits do not specify instrumentation.
+struct null_resource_instrumentation
+{
+    template< typename Resource >
+    static void on_acquire(void const*, Resource const&) noexcept
+    {
+    }
+
+    template< typename Resource >
+    static void on_release(void const*, Resource const&) noexcept
+    {
+    }
+
+    template< typename Resource >
+    static void on_reset(void const*, Resource const&) noexcept
+    {
+    }
+
+    template< typename Resource >
+    static void on_move(void const*, void const*, Resource const&) noexcept
+    {
+    }
+
+    static void on_swap(void const*, void const*) noexcept
+    {
+    }
+};
+
+#if !defined(BOOST_SCOPE_DISABLE_INSTRUMENTATION)
+
+template< typename Traits >
+struct resource_instrumentation_impl
+{
+    template< typename T, typename Instrumentation = typename T::instrumentation >
+    static Instrumentation _get_instrumentation(int);
+    template< typename T >
+    static null_resource_instrumentation _get_instrumentation(...);
+
+    using type = decltype(resource_instrumentation_impl::_get_instrumentation< Traits >(0));
+};
+
+#endif // !defined(BOOST_SCOPE_DISABLE_INSTRUMENTATION)
+
+/*!
+ * The type trait produces instrumentation type for the given resource traits. If the traits define
+ * a nested \c instrumentation type, that type is produced. Otherwise, or if instrumentation is disabled
+ * by defining \c BOOST_SCOPE_DISABLE_INSTRUMENTATION, \c null_resource_instrumentation is produced.
+ */
+template< typename Traits >
+struct resource_instrumentation
+{
+#if !defined(BOOST_SCOPE_DISABLE_INSTRUMENTATION)
+    using type = typename resource_instrumentation_impl< Traits >::type;
+#else
+    using type = null_resource_instrumentation;
+#endif
+    static constexpr bool enabled = !std::is_same< type, null_resource_instrumentation >::value;
+};
+
+template< >
+struct resource_instrumentation< void >
+{
+    using type = null_resource_instrumentation;
+    static constexpr bool enabled = false;
+};
+
+//! Calls \c on_acquire with the resource site, if the instrumentation supports it, or without it otherwise
+template< typename Instrumentation >
+struct resource_acquire_notifier
+{
+    template< typename I, typename Resource >
+    static auto _notify(void const* owner, Resource const& res, resource_site const& site, int) noexcept
+        -> decltype(I::on_acquire(owner, res, site), void())
+    {
+        I::on_acquire(owner, res, site);
+    }
+
+    template< typename I, typename Resource >
+    static void _notify(void const* owner, Resource const& res, resource_site const&, ...) noexcept
+    {
+        I::on_acquire(owner, res);
+    }
+
+    template< typename Resource >
+    static void notify(void const* owner, Resource const& res, resource_site const& site) noexcept
+    {
+        resource_acquire_notifier::_notify< Instrumentation >(owner, res, site, 0);
+    }
+};
+
+} // namespace detail
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_DETAIL_RESOURCE_INSTRUMENTATION_HPP_INCLUDED_
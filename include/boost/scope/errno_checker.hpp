@@ -0,0 +1,111 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/errno_checker.hpp
+ *
+ * This header contains definition of \c errno_checker type.
+ */
+
+#ifndef BOOST_SCOPE_ERRNO_CHECKER_HPP_INCLUDED_
+#define BOOST_SCOPE_ERRNO_CHECKER_HPP_INCLUDED_
+
+#include <cerrno>
+#include <type_traits>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/cold_action.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief A predicate for checking whether \c errno has changed.
+ *
+ * On construction, the predicate saves the current value of \c errno and resets \c errno
+ * to zero. When called, the predicate returns \c true if the current value of \c errno is
+ * non-zero, which is taken as an error indication. Otherwise, the predicate returns \c false.
+ *
+ * \note Some functions may modify \c errno even when they succeed. The predicate should only
+ *       be used in scopes where \c errno is only modified by failing operations.
+ */
+class errno_checker
+{
+public:
+    //! Predicate result type
+    using result_type = bool;
+
+private:
+    int m_errno;
+
+public:
+    /*!
+     * \brief Constructs the predicate.
+     *
+     * Upon construction, the predicate saves the current value of \c errno and then sets
+     * \c errno to zero.
+     *
+     * **Throws:** Nothing.
+     */
+    errno_checker() noexcept :
+        m_errno(errno)
+    {
+        errno = 0;
+    }
+
+    /*!
+     * \brief Checks if \c errno indicates an error.
+     *
+     * **Throws:** Nothing.
+     *
+     * \returns \c true if the current value of \c errno is non-zero, otherwise \c false.
+     */
+    result_type operator()() const noexcept
+    {
+        return errno != 0;
+    }
+
+    /*!
+     * \brief Returns the value of \c errno captured on construction, before it was reset to zero.
+     *
+     * **Throws:** Nothing.
+     */
+    int captured_errno() const noexcept
+    {
+        return m_errno;
+    }
+};
+
+/*!
+ * \brief Creates a predicate for checking whether \c errno has changed
+ *
+ * **Throws:** Nothing.
+ */
+inline errno_checker check_errno() noexcept
+{
+    return errno_checker();
+}
+
+//! \cond
+namespace detail {
+
+template< >
+struct is_failure_condition< errno_checker > : public std::true_type { };
+
+} // namespace detail
+//! \endcond
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_ERRNO_CHECKER_HPP_INCLUDED_
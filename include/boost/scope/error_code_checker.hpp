@@ -14,8 +14,10 @@
 #ifndef BOOST_SCOPE_ERROR_CODE_CHECKER_HPP_INCLUDED_
 #define BOOST_SCOPE_ERROR_CODE_CHECKER_HPP_INCLUDED_
 
+#include <type_traits>
 #include <boost/core/addressof.hpp>
 #include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/cold_action.hpp>
 #include <boost/scope/detail/header.hpp>
 
 #ifdef BOOST_HAS_PRAGMA_ONCE
@@ -95,6 +97,15 @@ inline error_code_checker< ErrorCode > check_error_code(ErrorCode& ec) noexcept
     return error_code_checker< ErrorCode >(ec);
 }
 
+//! \cond
+namespace detail {
+
+template< typename ErrorCode >
+struct is_failure_condition< error_code_checker< ErrorCode > > : public std::true_type { };
+
+} // namespace detail
+//! \endcond
+
 } // namespace scope
 } // namespace boost
 
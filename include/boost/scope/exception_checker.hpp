@@ -14,8 +14,10 @@
 #ifndef BOOST_SCOPE_EXCEPTION_CHECKER_HPP_INCLUDED_
 #define BOOST_SCOPE_EXCEPTION_CHECKER_HPP_INCLUDED_
 
+#include <type_traits>
 #include <boost/assert.hpp>
 #include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/cold_action.hpp>
 #include <boost/core/uncaught_exceptions.hpp>
 #include <boost/scope/detail/header.hpp>
 
@@ -43,6 +45,11 @@ namespace scope {
  *       is cached after construction and is invoked after the thread has left the scope
  *       where the predicate was constructed (e.g. when the predicate is stored as a class
  *       data member or a namespace-scope variable).
+ *
+ * \note If exceptions are disabled (i.e. \c BOOST_NO_EXCEPTIONS is defined), the predicate
+ *       does not store any data and always returns \c false. This makes \c scope_fail guards
+ *       that use this predicate never execute their actions and \c scope_success guards always
+ *       execute them.
  */
 class exception_checker
 {
@@ -50,8 +57,10 @@ public:
     //! Predicate result type
     using result_type = bool;
 
+#if !defined(BOOST_NO_EXCEPTIONS)
 private:
     unsigned int m_uncaught_count;
+#endif
 
 public:
     /*!
@@ -63,10 +72,14 @@ public:
      *
      * **Throws:** Nothing.
      */
+#if !defined(BOOST_NO_EXCEPTIONS)
     exception_checker() noexcept :
         m_uncaught_count(boost::core::uncaught_exceptions())
     {
     }
+#else
+    exception_checker() = default;
+#endif
 
     /*!
      * \brief Checks if an exception is being thrown.
@@ -79,12 +92,16 @@ public:
      */
     result_type operator()() const noexcept
     {
+#if !defined(BOOST_NO_EXCEPTIONS)
         const unsigned int uncaught_count = boost::core::uncaught_exceptions();
         // If this assertion fails, the predicate is likely being used in an unsupported
         // way, where it is called in a different scope or thread context from where
         // it was constructed.
         BOOST_ASSERT((uncaught_count - m_uncaught_count) <= 1u);
         return uncaught_count > m_uncaught_count;
+#else
+        return false;
+#endif
     }
 };
 
@@ -98,6 +115,15 @@ inline exception_checker check_exception() noexcept
     return exception_checker();
 }
 
+//! \cond
+namespace detail {
+
+template< >
+struct is_failure_condition< exception_checker > : public std::true_type { };
+
+} // namespace detail
+//! \endcond
+
 } // namespace scope
 } // namespace boost
 
@@ -0,0 +1,210 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/failure_scope.hpp
+ *
+ * This header contains definition of \c failure_scope and \c shared_exception_checker types.
+ */
+
+#ifndef BOOST_SCOPE_FAILURE_SCOPE_HPP_INCLUDED_
+#define BOOST_SCOPE_FAILURE_SCOPE_HPP_INCLUDED_
+
+#include <type_traits>
+#include <boost/assert.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/cold_action.hpp>
+#include <boost/core/uncaught_exceptions.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+class shared_exception_checker;
+
+/*!
+ * \brief A snapshot of the number of uncaught exceptions, shared by multiple scope guards.
+ *
+ * On construction, the object captures the current number of uncaught exceptions. Scope guards,
+ * such as \c scope_fail and \c scope_success, can use \c shared_exception_checker predicates that
+ * refer to the \c failure_scope object instead of \c exception_checker, which captures the number
+ * of uncaught exceptions in every predicate. The first predicate call after leaving the scope queries
+ * the number of uncaught exceptions and caches the result, which is then reused by the following
+ * predicate calls. This reduces the number of queries when a function has many scope guards.
+ *
+ * ```
+ * boost::scope::failure_scope fs;
+ * boost::scope::scope_fail rollback1([&] { undo_step1(); }, fs.checker());
+ * step1();
+ * boost::scope::scope_fail rollback2([&] { undo_step2(); }, fs.checker());
+ * step2();
+ * ```
+ *
+ * \note The \c failure_scope object must be constructed before the scope guards that use it and
+ *       in the same scope, so that all of them are destroyed at the same point of execution.
+ *       If a scope guard is destroyed earlier, e.g. in a nested scope, the cached result may not
+ *       be correct for the remaining scope guards.
+ *
+ * \note Same as \c exception_checker, \c failure_scope is incompatible with C++20 coroutines and
+ *       similar facilities, where the thread of execution may be suspended and resumed in a
+ *       different context.
+ *
+ * \note If exceptions are disabled (i.e. \c BOOST_NO_EXCEPTIONS is defined), \c failed always returns \c false.
+ */
+class failure_scope
+{
+//! \cond
+#if !defined(BOOST_NO_EXCEPTIONS)
+private:
+    enum state : unsigned char
+    {
+        unknown,
+        failed_state,
+        succeeded_state
+    };
+
+    unsigned int m_uncaught_count;
+    mutable state m_state;
+#endif
+//! \endcond
+
+public:
+    /*!
+     * \brief Constructs the object.
+     *
+     * Upon construction, the object saves the current number of uncaught exceptions.
+     *
+     * **Throws:** Nothing.
+     */
+#if !defined(BOOST_NO_EXCEPTIONS)
+    failure_scope() noexcept :
+        m_uncaught_count(boost::core::uncaught_exceptions()),
+        m_state(unknown)
+    {
+    }
+#else
+    failure_scope() = default;
+#endif
+
+    failure_scope(failure_scope const&) = delete;
+    failure_scope& operator= (failure_scope const&) = delete;
+
+    /*!
+     * \brief Checks if an exception is being thrown.
+     *
+     * The first call queries the current number of uncaught exceptions and caches the result.
+     * Subsequent calls return the cached result.
+     *
+     * **Throws:** Nothing.
+     *
+     * \returns \c true if the number of uncaught exceptions at the point of the first call is
+     *          greater than that at the point of construction, otherwise \c false.
+     */
+    bool failed() const noexcept
+    {
+#if !defined(BOOST_NO_EXCEPTIONS)
+        if (m_state == unknown)
+        {
+            m_state = query() ? failed_state : succeeded_state;
+        }
+        else
+        {
+            // If this assertion fails, the scope guards sharing the snapshot are likely destroyed
+            // at different points of execution
+            BOOST_ASSERT(m_state == (query() ? failed_state : succeeded_state));
+        }
+
+        return m_state == failed_state;
+#else
+        return false;
+#endif
+    }
+
+    /*!
+     * \brief Returns a predicate for scope guards that refers to this object.
+     *
+     * **Throws:** Nothing.
+     */
+    shared_exception_checker checker() const noexcept;
+
+#if !defined(BOOST_NO_EXCEPTIONS)
+//! \cond
+private:
+    bool query() const noexcept
+    {
+        const unsigned int uncaught_count = boost::core::uncaught_exceptions();
+        BOOST_ASSERT((uncaught_count - m_uncaught_count) <= 1u);
+        return uncaught_count > m_uncaught_count;
+    }
+//! \endcond
+#endif
+};
+
+/*!
+ * \brief A predicate for checking whether an exception is being thrown, using a shared \c failure_scope.
+ *
+ * The predicate refers to a \c failure_scope object, which must outlive the predicate.
+ */
+class shared_exception_checker
+{
+public:
+    //! Predicate result type
+    using result_type = bool;
+
+private:
+    failure_scope const* m_scope;
+
+public:
+    /*!
+     * \brief Constructs the predicate.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param scope Failure scope the predicate refers to.
+     */
+    explicit shared_exception_checker(failure_scope const& scope) noexcept :
+        m_scope(&scope)
+    {
+    }
+
+    /*!
+     * \brief Checks if an exception is being thrown.
+     *
+     * **Throws:** Nothing.
+     *
+     * \returns `scope.failed()`, where \c scope is the \c failure_scope object the predicate refers to.
+     */
+    result_type operator()() const noexcept
+    {
+        return m_scope->failed();
+    }
+};
+
+inline shared_exception_checker failure_scope::checker() const noexcept
+{
+    return shared_exception_checker(*this);
+}
+
+//! \cond
+namespace detail {
+
+template< >
+struct is_failure_condition< shared_exception_checker > : public std::true_type { };
+
+} // namespace detail
+//! \endcond
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_FAILURE_SCOPE_HPP_INCLUDED_
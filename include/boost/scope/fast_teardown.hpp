@@ -0,0 +1,99 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/fast_teardown.hpp
+ *
+ * This header contains definition of the process-wide fast teardown mode switch.
+ */
+
+#ifndef BOOST_SCOPE_FAST_TEARDOWN_HPP_INCLUDED_
+#define BOOST_SCOPE_FAST_TEARDOWN_HPP_INCLUDED_
+
+#include <atomic>
+#include <type_traits>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+//! \cond
+namespace detail {
+
+//! Process-wide fast teardown mode flag
+template< typename T = void >
+struct fast_teardown_flag
+{
+    static std::atomic< bool > value;
+};
+
+template< typename T >
+std::atomic< bool > fast_teardown_flag< T >::value(false);
+
+template< typename Traits >
+struct is_skippable_on_teardown_impl
+{
+    template< typename T, bool Value = T::skip_deleter_on_teardown >
+    static std::integral_constant< bool, Value > _is_skippable_on_teardown_check(int);
+    template< typename T >
+    static std::false_type _is_skippable_on_teardown_check(...);
+
+    using type = decltype(is_skippable_on_teardown_impl::_is_skippable_on_teardown_check< Traits >(0));
+};
+
+/*!
+ * The type trait indicates whether resource traits allow to skip calling the deleter in fast teardown mode.
+ * This is the case if the traits define a static constant \c skip_deleter_on_teardown that is \c true.
+ */
+template< typename Traits >
+struct is_skippable_on_teardown : public is_skippable_on_teardown_impl< Traits >::type { };
+
+template< >
+struct is_skippable_on_teardown< void > : public std::false_type { };
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Enables fast teardown mode.
+ *
+ * In fast teardown mode, \c unique_resource destructors do not invoke the deleter if the resource traits
+ * define a static constant \c skip_deleter_on_teardown with value \c true. This is intended to be used
+ * at process termination, when the operating system will reclaim the resources anyway, to speed up
+ * destruction of a large number of \c unique_resource objects. Deleters of resources that must be
+ * freed before the process terminates, for example, ones that flush buffered data, are still called.
+ *
+ * Once enabled, the mode cannot be disabled.
+ *
+ * **Throws:** Nothing.
+ */
+inline void enable_fast_teardown() noexcept
+{
+    detail::fast_teardown_flag<>::value.store(true, std::memory_order_relaxed);
+}
+
+/*!
+ * \brief Returns \c true if fast teardown mode is enabled.
+ *
+ * **Throws:** Nothing.
+ */
+inline bool is_fast_teardown_enabled() noexcept
+{
+    return detail::fast_teardown_flag<>::value.load(std::memory_order_relaxed);
+}
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_FAST_TEARDOWN_HPP_INCLUDED_
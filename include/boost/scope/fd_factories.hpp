@@ -0,0 +1,374 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/fd_factories.hpp
+ *
+ * This header contains definition of factory functions that create file descriptors
+ * with the close-on-exec flag set and wrap them in \c unique_fd.
+ *
+ * The functions are only available on POSIX systems.
+ */
+
+#ifndef BOOST_SCOPE_FD_FACTORIES_HPP_INCLUDED_
+#define BOOST_SCOPE_FD_FACTORIES_HPP_INCLUDED_
+
+#include <boost/scope/detail/config.hpp>
+
+#if !defined(BOOST_WINDOWS)
+
+#include <cerrno>
+#include <utility>
+#include <system_error>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
+#include <boost/assert.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if (defined(__linux__) && (defined(_GNU_SOURCE) || defined(__ANDROID__))) || \
+    defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__DragonFly__)
+#define BOOST_SCOPE_DETAIL_HAS_ACCEPT4
+#define BOOST_SCOPE_DETAIL_HAS_PIPE2
+#endif
+
+namespace boost {
+namespace scope {
+
+//! \cond
+namespace detail {
+
+//! Returns an error code for the current \c errno value
+inline std::error_code last_fd_error() noexcept
+{
+    return std::error_code(errno, std::generic_category());
+}
+
+//! Sets the close-on-exec flag on the file descriptor, closes the file descriptor on failure
+inline void set_cloexec(unique_fd& fd, std::error_code& ec) noexcept
+{
+    if (fd.allocated() && BOOST_UNLIKELY(::fcntl(fd.get(), F_SETFD, FD_CLOEXEC) < 0))
+    {
+        ec = last_fd_error();
+        fd.reset();
+    }
+}
+
+//! Wraps the result of a function that creates a file descriptor in \c unique_fd
+inline unique_fd make_unique_fd(int fd, std::error_code& ec) noexcept
+{
+    if (BOOST_UNLIKELY(fd < 0))
+        ec = last_fd_error();
+    else
+        ec.clear();
+    return unique_fd(fd);
+}
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Opens a file.
+ *
+ * **Effects:** Calls `open(path, flags | O_CLOEXEC, mode)`, retrying if the call is interrupted by a signal.
+ *              If \c O_CLOEXEC is not supported by the system, sets \c FD_CLOEXEC on the opened file descriptor
+ *              with a separate call.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param path File name.
+ * \param flags File open flags, as accepted by \c open.
+ * \param mode File permissions, if a new file is created.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The opened file descriptor. If an error occurs, the returned \c unique_fd does not hold a file descriptor.
+ */
+inline unique_fd open_fd(const char* path, int flags, mode_t mode, std::error_code& ec) noexcept
+{
+    int fd;
+#if defined(O_CLOEXEC)
+    while (true)
+    {
+        fd = ::open(path, flags | O_CLOEXEC, mode);
+        if (BOOST_LIKELY(fd >= 0) || errno != EINTR)
+            break;
+    }
+
+    return detail::make_unique_fd(fd, ec);
+#else
+    while (true)
+    {
+        fd = ::open(path, flags, mode);
+        if (BOOST_LIKELY(fd >= 0) || errno != EINTR)
+            break;
+    }
+
+    unique_fd res = detail::make_unique_fd(fd, ec);
+    detail::set_cloexec(res, ec);
+    return res;
+#endif
+}
+
+/*!
+ * \brief Opens a file.
+ *
+ * **Effects:** Equivalent to `open_fd(path, flags, 0, ec)`.
+ */
+inline unique_fd open_fd(const char* path, int flags, std::error_code& ec) noexcept
+{
+    return open_fd(path, flags, static_cast< mode_t >(0), ec);
+}
+
+/*!
+ * \brief Creates a socket.
+ *
+ * **Effects:** Calls `socket(domain, type | SOCK_CLOEXEC, protocol)`. If \c SOCK_CLOEXEC is not supported by
+ *              the system, sets \c FD_CLOEXEC on the created socket with a separate call.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param domain Communication domain, e.g. \c AF_INET.
+ * \param type Socket type, e.g. \c SOCK_STREAM, optionally combined with \c SOCK_NONBLOCK, where supported.
+ * \param protocol Socket protocol.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The created socket. If an error occurs, the returned \c unique_fd does not hold a file descriptor.
+ */
+inline unique_fd socket_fd(int domain, int type, int protocol, std::error_code& ec) noexcept
+{
+#if defined(SOCK_CLOEXEC)
+    return detail::make_unique_fd(::socket(domain, type | SOCK_CLOEXEC, protocol), ec);
+#else
+    unique_fd res = detail::make_unique_fd(::socket(domain, type, protocol), ec);
+    detail::set_cloexec(res, ec);
+    return res;
+#endif
+}
+
+/*!
+ * \brief Accepts a connection on a listening socket.
+ *
+ * **Effects:** Calls `accept4(sockfd, addr, addrlen, flags | SOCK_CLOEXEC)`, retrying if the call is interrupted
+ *              by a signal. If \c accept4 is not supported by the system, calls \c accept and sets \c FD_CLOEXEC
+ *              on the accepted socket with a separate call. In this case, \a flags must be zero.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param sockfd Listening socket.
+ * \param addr Pointer to the buffer for the peer address. Can be \c nullptr.
+ * \param addrlen Pointer to the size of the \a addr buffer. Can be \c nullptr if \a addr is \c nullptr.
+ * \param flags Additional flags for the accepted socket, e.g. \c SOCK_NONBLOCK.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The accepted socket. If an error occurs, the returned \c unique_fd does not hold a file descriptor.
+ */
+inline unique_fd accept_fd(int sockfd, struct sockaddr* addr, socklen_t* addrlen, int flags, std::error_code& ec) noexcept
+{
+    int fd;
+#if defined(BOOST_SCOPE_DETAIL_HAS_ACCEPT4)
+    while (true)
+    {
+        fd = ::accept4(sockfd, addr, addrlen, flags | SOCK_CLOEXEC);
+        if (BOOST_LIKELY(fd >= 0) || errno != EINTR)
+            break;
+    }
+
+    return detail::make_unique_fd(fd, ec);
+#else
+    BOOST_ASSERT(flags == 0);
+    static_cast< void >(flags);
+    while (true)
+    {
+        fd = ::accept(sockfd, addr, addrlen);
+        if (BOOST_LIKELY(fd >= 0) || errno != EINTR)
+            break;
+    }
+
+    unique_fd res = detail::make_unique_fd(fd, ec);
+    detail::set_cloexec(res, ec);
+    return res;
+#endif
+}
+
+/*!
+ * \brief Accepts a connection on a listening socket.
+ *
+ * **Effects:** Equivalent to `accept_fd(sockfd, addr, addrlen, 0, ec)`.
+ */
+inline unique_fd accept_fd(int sockfd, struct sockaddr* addr, socklen_t* addrlen, std::error_code& ec) noexcept
+{
+    return accept_fd(sockfd, addr, addrlen, 0, ec);
+}
+
+/*!
+ * \brief Accepts a connection on a listening socket.
+ *
+ * **Effects:** Equivalent to `accept_fd(sockfd, nullptr, nullptr, 0, ec)`.
+ */
+inline unique_fd accept_fd(int sockfd, std::error_code& ec) noexcept
+{
+    return accept_fd(sockfd, nullptr, nullptr, 0, ec);
+}
+
+/*!
+ * \brief Creates a pipe.
+ *
+ * **Effects:** Calls `pipe2(fds, flags | O_CLOEXEC)`. If \c pipe2 is not supported by the system, calls \c pipe and
+ *              sets \c FD_CLOEXEC on both file descriptors with separate calls. In this case, \a flags must be zero.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param flags Additional flags for the pipe file descriptors, e.g. \c O_NONBLOCK.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns A pair of file descriptors, where the first one is the read end and the second one is the write end of
+ *          the pipe. If an error occurs, the returned \c unique_fd objects do not hold file descriptors.
+ */
+inline std::pair< unique_fd, unique_fd > pipe_fds(int flags, std::error_code& ec) noexcept
+{
+    int fds[2];
+#if defined(BOOST_SCOPE_DETAIL_HAS_PIPE2)
+    if (BOOST_UNLIKELY(::pipe2(fds, flags | O_CLOEXEC) < 0))
+    {
+        ec = detail::last_fd_error();
+        return std::pair< unique_fd, unique_fd >();
+    }
+
+    ec.clear();
+    return std::pair< unique_fd, unique_fd >(unique_fd(fds[0]), unique_fd(fds[1]));
+#else
+    BOOST_ASSERT(flags == 0);
+    static_cast< void >(flags);
+    if (BOOST_UNLIKELY(::pipe(fds) < 0))
+    {
+        ec = detail::last_fd_error();
+        return std::pair< unique_fd, unique_fd >();
+    }
+
+    ec.clear();
+    std::pair< unique_fd, unique_fd > res{ unique_fd(fds[0]), unique_fd(fds[1]) };
+    detail::set_cloexec(res.first, ec);
+    detail::set_cloexec(res.second, ec);
+    if (BOOST_UNLIKELY(!!ec))
+    {
+        res.first.reset();
+        res.second.reset();
+    }
+    return res;
+#endif
+}
+
+/*!
+ * \brief Creates a pipe.
+ *
+ * **Effects:** Equivalent to `pipe_fds(0, ec)`.
+ */
+inline std::pair< unique_fd, unique_fd > pipe_fds(std::error_code& ec) noexcept
+{
+    return pipe_fds(0, ec);
+}
+
+/*!
+ * \brief Duplicates a file descriptor.
+ *
+ * **Effects:** Calls `fcntl(fd, F_DUPFD_CLOEXEC, min_fd)`.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param fd File descriptor to duplicate.
+ * \param min_fd The minimum value of the new file descriptor.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The new file descriptor. If an error occurs, the returned \c unique_fd does not hold a file descriptor.
+ */
+inline unique_fd dup_fd(int fd, int min_fd, std::error_code& ec) noexcept
+{
+#if defined(F_DUPFD_CLOEXEC)
+    return detail::make_unique_fd(::fcntl(fd, F_DUPFD_CLOEXEC, min_fd), ec);
+#else
+    unique_fd res = detail::make_unique_fd(::fcntl(fd, F_DUPFD, min_fd), ec);
+    detail::set_cloexec(res, ec);
+    return res;
+#endif
+}
+
+/*!
+ * \brief Duplicates a file descriptor.
+ *
+ * **Effects:** Equivalent to `dup_fd(fd, 0, ec)`.
+ */
+inline unique_fd dup_fd(int fd, std::error_code& ec) noexcept
+{
+    return dup_fd(fd, 0, ec);
+}
+
+#if defined(__linux__) || defined(BOOST_SCOPE_DOXYGEN)
+
+/*!
+ * \brief Creates an event file descriptor.
+ *
+ * **Effects:** Calls `eventfd(initval, flags | EFD_CLOEXEC)`.
+ *
+ * **Throws:** Nothing.
+ *
+ * \note This function is only available on Linux.
+ *
+ * \param initval Initial value of the event counter.
+ * \param flags Additional flags, e.g. \c EFD_NONBLOCK or \c EFD_SEMAPHORE.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The created file descriptor. If an error occurs, the returned \c unique_fd does not hold a file descriptor.
+ */
+inline unique_fd eventfd_fd(unsigned int initval, int flags, std::error_code& ec) noexcept
+{
+    return detail::make_unique_fd(::eventfd(initval, flags | EFD_CLOEXEC), ec);
+}
+
+/*!
+ * \brief Creates an anonymous memory-backed file.
+ *
+ * **Effects:** Calls `memfd_create(name, flags | MFD_CLOEXEC)`. If the system call is not supported by the kernel
+ *              or the C library, returns an error.
+ *
+ * **Throws:** Nothing.
+ *
+ * \note This function is only available on Linux.
+ *
+ * \param name Name of the file, for debugging purposes.
+ * \param flags Additional flags, e.g. \c MFD_ALLOW_SEALING.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The created file descriptor. If an error occurs, the returned \c unique_fd does not hold a file descriptor.
+ */
+inline unique_fd memfd_fd(const char* name, unsigned int flags, std::error_code& ec) noexcept
+{
+#if defined(SYS_memfd_create)
+    // MFD_CLOEXEC
+    const unsigned int cloexec_flag = 1u;
+    return detail::make_unique_fd(static_cast< int >(::syscall(SYS_memfd_create, name, flags | cloexec_flag)), ec);
+#else
+    static_cast< void >(name);
+    static_cast< void >(flags);
+    ec = std::make_error_code(std::errc::function_not_supported);
+    return unique_fd();
+#endif
+}
+
+#endif // defined(__linux__) || defined(BOOST_SCOPE_DOXYGEN)
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // !defined(BOOST_WINDOWS)
+
+#endif // BOOST_SCOPE_FD_FACTORIES_HPP_INCLUDED_
@@ -0,0 +1,269 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/fd_passing.hpp
+ *
+ * This header contains definition of functions for passing file descriptors
+ * between processes over Unix domain sockets.
+ *
+ * The functions are only available on POSIX systems.
+ */
+
+#ifndef BOOST_SCOPE_FD_PASSING_HPP_INCLUDED_
+#define BOOST_SCOPE_FD_PASSING_HPP_INCLUDED_
+
+#include <boost/scope/detail/config.hpp>
+
+#if !defined(BOOST_WINDOWS)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <system_error>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/fd_factories.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief The maximum number of file descriptors sent in a single message by \c send_fds.
+ *
+ * This matches the limit of the Linux kernel (\c SCM_MAX_FD).
+ */
+BOOST_CONSTEXPR_OR_CONST std::size_t max_fds_per_message = 253u;
+
+//! \cond
+namespace detail {
+
+#if defined(MSG_NOSIGNAL)
+BOOST_CONSTEXPR_OR_CONST int send_fds_flags = MSG_NOSIGNAL;
+#else
+BOOST_CONSTEXPR_OR_CONST int send_fds_flags = 0;
+#endif
+
+#if defined(MSG_CMSG_CLOEXEC)
+BOOST_CONSTEXPR_OR_CONST int recv_fds_flags = MSG_CMSG_CLOEXEC;
+#else
+BOOST_CONSTEXPR_OR_CONST int recv_fds_flags = 0;
+#endif
+
+//! Sends a single message with up to \c max_fds_per_message file descriptors
+inline bool send_fds_message(int sock, unique_fd const* fds, std::size_t count, std::error_code& ec) noexcept
+{
+    union
+    {
+        struct cmsghdr header;
+        unsigned char buffer[CMSG_SPACE(sizeof(int) * max_fds_per_message)];
+    }
+    control;
+    std::memset(&control, 0, sizeof(control));
+
+    // Stream sockets require at least one byte of data to be sent along with the control message
+    unsigned char data = 0u;
+    struct iovec iov = {};
+    iov.iov_base = &data;
+    iov.iov_len = 1u;
+
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+    unsigned char* fd_data = CMSG_DATA(cmsg);
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+        const int fd = fds[i].get();
+        std::memcpy(fd_data + i * sizeof(int), &fd, sizeof(int));
+    }
+
+    while (true)
+    {
+        if (BOOST_LIKELY(::sendmsg(sock, &msg, send_fds_flags) >= 0))
+            return true;
+
+        const int err = errno;
+        if (err != EINTR)
+        {
+            ec = std::error_code(err, std::generic_category());
+            return false;
+        }
+    }
+}
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Sends file descriptors over a Unix domain socket.
+ *
+ * **Effects:** Sends the file descriptors in \c SCM_RIGHTS control messages, packing up to \c max_fds_per_message
+ *              file descriptors in a single \c sendmsg call. Each message carries one byte of data. The file descriptors
+ *              remain owned by the caller. Retries the calls if they are interrupted by a signal.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param sock Unix domain socket.
+ * \param fds Pointer to the array of file descriptors to send. All file descriptors must be valid.
+ * \param count Number of file descriptors to send.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The number of file descriptors that were sent. If an error occurs, the returned value is
+ *          less than \a count and is a multiple of \c max_fds_per_message.
+ */
+inline std::size_t send_fds(int sock, unique_fd const* fds, std::size_t count, std::error_code& ec) noexcept
+{
+    ec.clear();
+    std::size_t sent = 0u;
+    while (sent < count)
+    {
+        std::size_t n = count - sent;
+        if (n > max_fds_per_message)
+            n = max_fds_per_message;
+
+        if (BOOST_UNLIKELY(!detail::send_fds_message(sock, fds + sent, n, ec)))
+            break;
+
+        sent += n;
+    }
+
+    return sent;
+}
+
+/*!
+ * \brief Sends file descriptors over a Unix domain socket.
+ *
+ * **Effects:** Equivalent to `send_fds(sock, fds.data(), fds.size(), ec)`.
+ */
+template< typename Allocator >
+inline std::size_t send_fds(int sock, std::vector< unique_fd, Allocator > const& fds, std::error_code& ec) noexcept
+{
+    return send_fds(sock, fds.data(), fds.size(), ec);
+}
+
+/*!
+ * \brief Receives file descriptors over a Unix domain socket.
+ *
+ * **Effects:** Receives one message sent by \c send_fds and takes ownership of the file descriptors passed in it.
+ *              The received file descriptors have the close-on-exec flag set. Where supported, this is done atomically
+ *              with \c MSG_CMSG_CLOEXEC. Retries the call if it is interrupted by a signal.
+ *
+ *              If the message contains more than \a max_count file descriptors, or the control data is otherwise truncated,
+ *              or processing of the received file descriptors fails, closes all file descriptors received in the message
+ *              and reports an error.
+ *
+ * **Throws:** \c std::bad_alloc if memory allocation fails. Memory is allocated before receiving the message.
+ *
+ * \param sock Unix domain socket.
+ * \param max_count The maximum number of file descriptors to receive in one message. Should not be less than the number
+ *                  of file descriptors sent in one message, which is at most \c max_fds_per_message for \c send_fds.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure. If the received message
+ *           is truncated, set to \c std::errc::message_size.
+ * \returns The received file descriptors. If an error occurs or the peer has closed the connection, the returned
+ *          array is empty.
+ */
+inline std::vector< unique_fd > recv_fds(int sock, std::size_t max_count, std::error_code& ec)
+{
+    const std::size_t control_size = CMSG_SPACE(sizeof(int) * max_count);
+
+    // CMSG_SPACE rounds the size up for alignment, so the kernel may pass more than max_count file descriptors
+    // without truncating the control data. Reserve capacity for all file descriptors that fit in the buffer.
+    std::vector< unique_fd > fds;
+    fds.reserve(control_size / sizeof(int));
+    // Note: Memory returned by operator new[] is suitably aligned for cmsghdr
+    std::unique_ptr< unsigned char[] > control(new unsigned char[control_size]());
+
+    unsigned char data = 0u;
+    struct iovec iov = {};
+    iov.iov_base = &data;
+    iov.iov_len = 1u;
+
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.get();
+    msg.msg_controllen = control_size;
+
+    ssize_t res;
+    while (true)
+    {
+        res = ::recvmsg(sock, &msg, detail::recv_fds_flags);
+        if (BOOST_LIKELY(res >= 0))
+            break;
+
+        const int err = errno;
+        if (err != EINTR)
+        {
+            ec = std::error_code(err, std::generic_category());
+            return fds;
+        }
+    }
+
+    ec.clear();
+
+    // Take ownership of all received file descriptors first, so that they are closed if an error occurs.
+    // The capacity is reserved, so push_back does not throw.
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+            continue;
+
+        const unsigned char* fd_data = CMSG_DATA(cmsg);
+        const std::size_t n = (cmsg->cmsg_len - static_cast< std::size_t >(fd_data - reinterpret_cast< const unsigned char* >(cmsg))) / sizeof(int);
+        for (std::size_t i = 0u; i < n && fds.size() < fds.capacity(); ++i)
+        {
+            int fd;
+            std::memcpy(&fd, fd_data + i * sizeof(int), sizeof(int));
+            fds.push_back(unique_fd(fd));
+        }
+    }
+
+    if (BOOST_UNLIKELY((msg.msg_flags & MSG_CTRUNC) != 0 || fds.size() > max_count))
+    {
+        ec = std::make_error_code(std::errc::message_size);
+        fds.clear();
+        return fds;
+    }
+
+#if !defined(MSG_CMSG_CLOEXEC)
+    for (unique_fd& fd : fds)
+    {
+        detail::set_cloexec(fd, ec);
+        if (BOOST_UNLIKELY(!!ec))
+        {
+            fds.clear();
+            break;
+        }
+    }
+#endif
+
+    return fds;
+}
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // !defined(BOOST_WINDOWS)
+
+#endif // BOOST_SCOPE_FD_PASSING_HPP_INCLUDED_
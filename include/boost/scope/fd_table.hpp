@@ -0,0 +1,381 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/fd_table.hpp
+ *
+ * This header contains definition of \c fd_table container.
+ */
+
+#ifndef BOOST_SCOPE_FD_TABLE_HPP_INCLUDED_
+#define BOOST_SCOPE_FD_TABLE_HPP_INCLUDED_
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief A container of file descriptors and associated values, indexed by file descriptor number.
+ *
+ * The container owns file descriptors, as \c unique_fd objects, along with values of type \c T associated
+ * with them. Since file descriptors are small non-negative integers that are typically allocated densely,
+ * the container stores elements in an array indexed by the file descriptor, which allows to look up
+ * the value associated with a file descriptor without hashing or searching. The array is split into pages
+ * of \c PageSize elements, which are allocated on demand, when a file descriptor that belongs to a page is
+ * first inserted. Pages are never deallocated until the container is destroyed.
+ *
+ * Pages are installed with an atomic compare-and-swap operation, therefore different threads may concurrently
+ * insert, look up and remove different file descriptors. Operations on the same file descriptor, as well as
+ * \c close_all and \c for_each, must be synchronized with other operations by the user.
+ *
+ * \tparam T Type of the values associated with file descriptors.
+ * \tparam PageSize Number of elements in a page. Must be a power of two.
+ */
+template< typename T, std::size_t PageSize = 256u >
+class fd_table
+{
+    static_assert(PageSize > 0u && (PageSize & (PageSize - 1u)) == 0u, "Boost.Scope: fd_table page size must be a power of two");
+
+public:
+    //! Type of the values associated with file descriptors
+    using value_type = T;
+    //! Size type
+    using size_type = std::size_t;
+
+    //! Number of elements in a page
+    static BOOST_CONSTEXPR_OR_CONST size_type page_size = PageSize;
+    //! Default maximum number of file descriptors that can be stored in the container
+    static BOOST_CONSTEXPR_OR_CONST size_type default_capacity = 1048576u;
+
+//! \cond
+private:
+    //! Container element
+    struct slot
+    {
+        unique_fd fd;
+        alignas(value_type) unsigned char storage[sizeof(value_type)];
+
+        value_type* value() noexcept
+        {
+            return static_cast< value_type* >(static_cast< void* >(storage));
+        }
+    };
+
+    //! A page of elements
+    struct page
+    {
+        slot slots[PageSize];
+    };
+
+private:
+    //! Maximum number of file descriptors
+    size_type m_capacity;
+    //! Pointers to pages
+    std::atomic< page* >* m_pages;
+    //! Number of stored file descriptors
+    std::atomic< size_type > m_size;
+//! \endcond
+
+public:
+    /*!
+     * \brief Constructs an empty container.
+     *
+     * **Effects:** Allocates the array of page pointers large enough to store file descriptors
+     *              in the range [0, \a capacity). No pages are allocated.
+     *
+     * **Throws:** \c std::bad_alloc if memory allocation fails.
+     *
+     * \param capacity Maximum number of file descriptors the container is able to store.
+     */
+    explicit fd_table(size_type capacity = default_capacity) :
+        m_capacity(capacity),
+        m_pages(new std::atomic< page* >[(capacity + (PageSize - 1u)) / PageSize]()),
+        m_size(0u)
+    {
+    }
+
+    fd_table(fd_table const&) = delete;
+    fd_table& operator= (fd_table const&) = delete;
+
+    /*!
+     * \brief Destroys the container.
+     *
+     * **Effects:** Destroys the stored values and closes the stored file descriptors, as if by calling \c close_all.
+     */
+    ~fd_table() noexcept
+    {
+        close_all();
+
+        for (size_type i = 0u, n = page_count(); i < n; ++i)
+            delete m_pages[i].load(std::memory_order_relaxed);
+        delete[] m_pages;
+    }
+
+    //! Returns the maximum number of file descriptors the container is able to store
+    size_type capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    //! Returns the number of stored file descriptors
+    size_type size() const noexcept
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    //! Returns \c true if the container does not store any file descriptors
+    bool empty() const noexcept
+    {
+        return size() == 0u;
+    }
+
+    /*!
+     * \brief Inserts a file descriptor and constructs the associated value.
+     *
+     * **Effects:** If \a fd is allocated, its value is less than `capacity()` and the container does not already
+     *              store a file descriptor with the same value, constructs the value from \a args and takes ownership
+     *              of the file descriptor. Otherwise, leaves \a fd unchanged.
+     *
+     * **Throws:** \c std::bad_alloc if memory allocation fails, or any exception thrown by the constructor of \c T.
+     *             If an exception is thrown, \a fd is left unchanged.
+     *
+     * \param fd File descriptor to insert.
+     * \param args Arguments for the value constructor.
+     * \returns Pointer to the constructed value, if the file descriptor was inserted, otherwise \c nullptr.
+     */
+    template< typename... Args >
+    value_type* emplace(unique_fd&& fd, Args&&... args)
+    {
+        const int n = fd.get();
+        if (!fd.allocated() || !is_in_range(n))
+            return nullptr;
+
+        slot& s = get_or_create_page(static_cast< size_type >(n) / PageSize)->slots[static_cast< size_type >(n) % PageSize];
+        if (s.fd.allocated())
+            return nullptr;
+
+        value_type* p = new (s.storage) value_type(static_cast< Args&& >(args)...);
+        s.fd = static_cast< unique_fd&& >(fd);
+        m_size.fetch_add(1u, std::memory_order_relaxed);
+        return p;
+    }
+
+    /*!
+     * \brief Looks up the value associated with a file descriptor.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param fd File descriptor to look up.
+     * \returns Pointer to the associated value, if the container stores \a fd, otherwise \c nullptr.
+     */
+    value_type* find(int fd) noexcept
+    {
+        slot* s = find_slot(fd);
+        return s ? s->value() : nullptr;
+    }
+
+    /*!
+     * \brief Looks up the value associated with a file descriptor.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param fd File descriptor to look up.
+     * \returns Pointer to the associated value, if the container stores \a fd, otherwise \c nullptr.
+     */
+    value_type const* find(int fd) const noexcept
+    {
+        slot* s = find_slot(fd);
+        return s ? s->value() : nullptr;
+    }
+
+    //! Returns \c true if the container stores the file descriptor \a fd
+    bool contains(int fd) const noexcept
+    {
+        return find_slot(fd) != nullptr;
+    }
+
+    /*!
+     * \brief Removes a file descriptor from the container without closing it.
+     *
+     * **Effects:** If the container stores \a fd, destroys the associated value and returns
+     *              the file descriptor. Otherwise, returns an unallocated \c unique_fd.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param fd File descriptor to remove.
+     */
+    unique_fd release(int fd) noexcept
+    {
+        slot* s = find_slot(fd);
+        if (!s)
+            return unique_fd();
+
+        s->value()->~value_type();
+        m_size.fetch_sub(1u, std::memory_order_relaxed);
+        return unique_fd(static_cast< unique_fd&& >(s->fd));
+    }
+
+    /*!
+     * \brief Removes and closes a file descriptor.
+     *
+     * **Effects:** If the container stores \a fd, destroys the associated value and closes the file descriptor
+     *              with \c fd_deleter.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param fd File descriptor to close.
+     * \returns \c true if the file descriptor was stored in the container, otherwise \c false.
+     */
+    bool close(int fd) noexcept
+    {
+        slot* s = find_slot(fd);
+        if (!s)
+            return false;
+
+        erase_slot(*s);
+        return true;
+    }
+
+    /*!
+     * \brief Removes and closes all file descriptors.
+     *
+     * **Effects:** Destroys all stored values and closes all stored file descriptors with \c fd_deleter.
+     *              Allocated pages are retained for reuse.
+     *
+     * **Throws:** Nothing.
+     *
+     * \returns The number of closed file descriptors.
+     */
+    size_type close_all() noexcept
+    {
+        size_type count = 0u;
+        for (size_type i = 0u, n = page_count(); i < n; ++i)
+        {
+            page* p = m_pages[i].load(std::memory_order_acquire);
+            if (!p)
+                continue;
+
+            for (size_type j = 0u; j < PageSize; ++j)
+            {
+                slot& s = p->slots[j];
+                if (s.fd.allocated())
+                {
+                    erase_slot(s);
+                    ++count;
+                }
+            }
+        }
+
+        return count;
+    }
+
+    /*!
+     * \brief Invokes a function on every stored file descriptor and the associated value.
+     *
+     * **Effects:** Calls `func(fd, value)` for every stored file descriptor \c fd, in ascending order,
+     *              where \c value is an lvalue reference to the associated value.
+     *
+     * **Throws:** Nothing, unless \a func throws.
+     */
+    template< typename Func >
+    void for_each(Func&& func)
+    {
+        for (size_type i = 0u, n = page_count(); i < n; ++i)
+        {
+            page* p = m_pages[i].load(std::memory_order_acquire);
+            if (!p)
+                continue;
+
+            for (size_type j = 0u; j < PageSize; ++j)
+            {
+                slot& s = p->slots[j];
+                if (s.fd.allocated())
+                    func(s.fd.get(), *s.value());
+            }
+        }
+    }
+
+//! \cond
+private:
+    //! Returns the number of page pointers
+    size_type page_count() const noexcept
+    {
+        return (m_capacity + (PageSize - 1u)) / PageSize;
+    }
+
+    //! Returns \c true if the file descriptor can be stored in the container
+    bool is_in_range(int fd) const noexcept
+    {
+        return fd >= 0 && static_cast< size_type >(fd) < m_capacity;
+    }
+
+    //! Returns the slot that stores the file descriptor or \c nullptr if there is no such slot
+    slot* find_slot(int fd) const noexcept
+    {
+        if (BOOST_UNLIKELY(!is_in_range(fd)))
+            return nullptr;
+
+        page* p = m_pages[static_cast< size_type >(fd) / PageSize].load(std::memory_order_acquire);
+        if (!p)
+            return nullptr;
+
+        slot& s = p->slots[static_cast< size_type >(fd) % PageSize];
+        return s.fd.allocated() ? &s : nullptr;
+    }
+
+    //! Returns the page with the given index, allocating it if needed
+    page* get_or_create_page(size_type index)
+    {
+        std::atomic< page* >& ptr = m_pages[index];
+        page* p = ptr.load(std::memory_order_acquire);
+        if (BOOST_LIKELY(p != nullptr))
+            return p;
+
+        page* new_page = new page();
+        if (ptr.compare_exchange_strong(p, new_page, std::memory_order_acq_rel, std::memory_order_acquire))
+            return new_page;
+
+        // Another thread has installed the page first
+        delete new_page;
+        return p;
+    }
+
+    //! Destroys the value and closes the file descriptor in the slot
+    void erase_slot(slot& s) noexcept
+    {
+        s.value()->~value_type();
+        s.fd.reset();
+        m_size.fetch_sub(1u, std::memory_order_relaxed);
+    }
+//! \endcond
+};
+
+#if defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+template< typename T, std::size_t PageSize >
+BOOST_CONSTEXPR_OR_CONST typename fd_table< T, PageSize >::size_type fd_table< T, PageSize >::page_size;
+template< typename T, std::size_t PageSize >
+BOOST_CONSTEXPR_OR_CONST typename fd_table< T, PageSize >::size_type fd_table< T, PageSize >::default_capacity;
+#endif
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_FD_TABLE_HPP_INCLUDED_
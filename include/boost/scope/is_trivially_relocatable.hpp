@@ -0,0 +1,81 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/is_trivially_relocatable.hpp
+ *
+ * This header contains definition of \c is_trivially_relocatable type trait.
+ */
+
+#ifndef BOOST_SCOPE_IS_TRIVIALLY_RELOCATABLE_HPP_INCLUDED_
+#define BOOST_SCOPE_IS_TRIVIALLY_RELOCATABLE_HPP_INCLUDED_
+
+#include <type_traits>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief The type trait indicates whether objects of type \c T are trivially relocatable.
+ *
+ * An object is trivially relocatable if move-constructing a new object from it and then
+ * destroying the original object is equivalent to copying the object representation
+ * (e.g. with \c std::memcpy) to the new location and not running the destructor of the
+ * original object. Containers may use this property to relocate elements more efficiently,
+ * for example, when growing the storage.
+ *
+ * By default, the trait is \c true for trivially copyable types and reference types. If the
+ * compiler supports [P1144](https://wg21.link/p1144) trivial relocatability, the trait also
+ * reflects types marked with the \c [[trivially_relocatable]] attribute. Users may specialize
+ * the trait for their types.
+ *
+ * The library specializes the trait for \c unique_resource, \c scope_exit, \c scope_success,
+ * \c scope_fail and \c defer_guard. The specializations are \c true if the types of the
+ * contained function objects and resources are trivially relocatable.
+ */
+template< typename T >
+struct is_trivially_relocatable :
+#if defined(__cpp_impl_trivially_relocatable) && (__cpp_impl_trivially_relocatable >= 202011l)
+    public std::integral_constant< bool, __is_trivially_relocatable(T) >
+#else
+    public std::is_trivially_copyable< T >::type
+#endif
+{
+};
+
+template< typename T >
+struct is_trivially_relocatable< T& > :
+    public std::true_type
+{
+};
+
+template< typename T >
+struct is_trivially_relocatable< T const > :
+    public is_trivially_relocatable< T >::type
+{
+};
+
+} // namespace scope
+} // namespace boost
+
+//! \cond
+#if defined(__cpp_impl_trivially_relocatable) && (__cpp_impl_trivially_relocatable >= 202011l)
+#define BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(...) [[trivially_relocatable(__VA_ARGS__)]]
+#else
+#define BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(...)
+#endif
+//! \endcond
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_IS_TRIVIALLY_RELOCATABLE_HPP_INCLUDED_
@@ -0,0 +1,236 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/latency_histogram.hpp
+ *
+ * This header contains definition of \c latency_histogram type.
+ */
+
+#ifndef BOOST_SCOPE_LATENCY_HISTOGRAM_HPP_INCLUDED_
+#define BOOST_SCOPE_LATENCY_HISTOGRAM_HPP_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+#include <boost/core/bit.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+namespace detail {
+
+class latency_recorder;
+
+} // namespace detail
+
+/*!
+ * \brief Log-linear histogram of latency values.
+ *
+ * The histogram divides the range of 64-bit unsigned values into buckets. Values below
+ * \c sub_bucket_count are recorded in individual buckets. Each power of two range above that
+ * is split into \c sub_bucket_count buckets of equal width. This makes the relative error
+ * of the recorded values not greater than `1 / sub_bucket_count`.
+ *
+ * The histogram does not interpret the recorded values, the values may represent
+ * time durations in any units.
+ */
+class latency_histogram
+{
+    friend class detail::latency_recorder;
+
+public:
+    //! Number of bits in the sub-bucket index
+    static BOOST_CONSTEXPR_OR_CONST unsigned int sub_bucket_bits = 4u;
+    //! Number of buckets in each power of two range of values
+    static BOOST_CONSTEXPR_OR_CONST std::size_t sub_bucket_count = static_cast< std::size_t >(1u) << sub_bucket_bits;
+    //! Total number of buckets
+    static BOOST_CONSTEXPR_OR_CONST std::size_t bucket_count = sub_bucket_count + (64u - sub_bucket_bits) * sub_bucket_count;
+
+private:
+    std::uint64_t m_counts[bucket_count];
+    std::uint64_t m_total_count;
+    std::uint64_t m_sum;
+
+public:
+    /*!
+     * \brief Constructs an empty histogram.
+     *
+     * **Throws:** Nothing.
+     */
+    latency_histogram() noexcept :
+        m_counts(),
+        m_total_count(0u),
+        m_sum(0u)
+    {
+    }
+
+    /*!
+     * \brief Returns index of the bucket for the value.
+     *
+     * **Throws:** Nothing.
+     */
+    static std::size_t bucket_index(std::uint64_t value) noexcept
+    {
+        if (value < sub_bucket_count)
+            return static_cast< std::size_t >(value);
+
+        const unsigned int exp = 63u - static_cast< unsigned int >(boost::core::countl_zero(value));
+        const std::size_t mantissa = static_cast< std::size_t >(value >> (exp - sub_bucket_bits)) & (sub_bucket_count - 1u);
+        return sub_bucket_count + (exp - sub_bucket_bits) * sub_bucket_count + mantissa;
+    }
+
+    /*!
+     * \brief Returns the lowest value that is recorded in the bucket.
+     *
+     * **Requires:** `index < bucket_count`.
+     *
+     * **Throws:** Nothing.
+     */
+    static std::uint64_t bucket_lower_bound(std::size_t index) noexcept
+    {
+        if (index < sub_bucket_count)
+            return index;
+
+        const unsigned int exp = static_cast< unsigned int >((index - sub_bucket_count) / sub_bucket_count) + sub_bucket_bits;
+        const std::uint64_t mantissa = static_cast< std::uint64_t >((index - sub_bucket_count) % sub_bucket_count);
+        return (static_cast< std::uint64_t >(1u) << exp) | (mantissa << (exp - sub_bucket_bits));
+    }
+
+    /*!
+     * \brief Returns the highest value that is recorded in the bucket.
+     *
+     * **Requires:** `index < bucket_count`.
+     *
+     * **Throws:** Nothing.
+     */
+    static std::uint64_t bucket_upper_bound(std::size_t index) noexcept
+    {
+        if ((index + 1u) < bucket_count)
+            return bucket_lower_bound(index + 1u) - 1u;
+
+        return ~static_cast< std::uint64_t >(0u);
+    }
+
+    /*!
+     * \brief Records a value in the histogram.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param value The value to record.
+     * \param count The number of times to record the value.
+     */
+    void record(std::uint64_t value, std::uint64_t count = 1u) noexcept
+    {
+        m_counts[bucket_index(value)] += count;
+        m_total_count += count;
+        m_sum += value * count;
+    }
+
+    /*!
+     * \brief Adds all recorded values from another histogram to this histogram.
+     *
+     * **Throws:** Nothing.
+     */
+    void merge(latency_histogram const& that) noexcept
+    {
+        for (std::size_t i = 0u; i < bucket_count; ++i)
+            m_counts[i] += that.m_counts[i];
+        m_total_count += that.m_total_count;
+        m_sum += that.m_sum;
+    }
+
+    /*!
+     * \brief Removes all recorded values.
+     *
+     * **Throws:** Nothing.
+     */
+    void clear() noexcept
+    {
+        for (std::size_t i = 0u; i < bucket_count; ++i)
+            m_counts[i] = 0u;
+        m_total_count = 0u;
+        m_sum = 0u;
+    }
+
+    /*!
+     * \brief Returns the number of values recorded in the bucket.
+     *
+     * **Requires:** `index < bucket_count`.
+     *
+     * **Throws:** Nothing.
+     */
+    std::uint64_t bucket(std::size_t index) const noexcept
+    {
+        return m_counts[index];
+    }
+
+    //! Returns the total number of recorded values
+    std::uint64_t total_count() const noexcept
+    {
+        return m_total_count;
+    }
+
+    //! Returns the sum of the recorded values
+    std::uint64_t sum() const noexcept
+    {
+        return m_sum;
+    }
+
+    //! Returns \c true if the histogram contains no values
+    bool empty() const noexcept
+    {
+        return m_total_count == 0u;
+    }
+
+    /*!
+     * \brief Returns an upper estimate of the value at the given quantile.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param q Quantile, in range [0, 1].
+     * \returns The upper bound of the bucket containing the value at the quantile \a q,
+     *          or 0 if the histogram is empty.
+     */
+    std::uint64_t value_at_quantile(double q) const noexcept
+    {
+        if (m_total_count == 0u)
+            return 0u;
+
+        if (q < 0.0)
+            q = 0.0;
+        else if (q > 1.0)
+            q = 1.0;
+
+        std::uint64_t rank = static_cast< std::uint64_t >(q * static_cast< double >(m_total_count) + 0.5);
+        if (rank == 0u)
+            rank = 1u;
+        else if (rank > m_total_count)
+            rank = m_total_count;
+
+        std::uint64_t cumulative_count = 0u;
+        for (std::size_t i = 0u; i < bucket_count; ++i)
+        {
+            cumulative_count += m_counts[i];
+            if (cumulative_count >= rank)
+                return bucket_upper_bound(i);
+        }
+
+        return bucket_upper_bound(bucket_count - 1u);
+    }
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_LATENCY_HISTOGRAM_HPP_INCLUDED_
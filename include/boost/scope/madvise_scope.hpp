@@ -0,0 +1,259 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/madvise_scope.hpp
+ *
+ * This header contains definition of \c madvise_scope scope guard, which applies
+ * memory residency hints to a memory region on scope entry and exit.
+ *
+ * The components are only available on POSIX systems.
+ */
+
+#ifndef BOOST_SCOPE_MADVISE_SCOPE_HPP_INCLUDED_
+#define BOOST_SCOPE_MADVISE_SCOPE_HPP_INCLUDED_
+
+#include <boost/scope/detail/config.hpp>
+
+#if !defined(BOOST_WINDOWS)
+
+#include <cerrno>
+#include <cstddef>
+#include <type_traits>
+#include <system_error>
+#include <sys/mman.h>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/is_trivially_relocatable.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief Memory residency hints.
+ *
+ * The hints can be combined with bitwise OR. Each hint corresponds to a \c madvise advice value.
+ * When multiple hints are specified, they are applied in the order of declaration in this enumeration.
+ * Hints that are not supported on the target system are not applied.
+ */
+enum class madvise_hints : unsigned int
+{
+    //! No hints
+    none = 0u,
+    //! \c MADV_WILLNEED - the region will be accessed soon, the system may read it ahead
+    willneed = 1u,
+    //! \c MADV_HUGEPAGE - enable transparent huge pages for the region
+    hugepage = 1u << 1u,
+    //! \c MADV_NOHUGEPAGE - disable transparent huge pages for the region
+    nohugepage = 1u << 2u,
+    //! \c MADV_COLD - deactivate the region pages, making them more likely to be reclaimed
+    cold = 1u << 3u,
+    //! \c MADV_PAGEOUT - reclaim the region pages, writing them to swap if needed
+    pageout = 1u << 4u,
+    //! \c MADV_DONTNEED - free the region pages. For private anonymous mappings, the contents are lost.
+    dontneed = 1u << 5u
+};
+
+//! Combines hints
+BOOST_CONSTEXPR inline madvise_hints operator| (madvise_hints left, madvise_hints right) noexcept
+{
+    return static_cast< madvise_hints >(static_cast< unsigned int >(left) | static_cast< unsigned int >(right));
+}
+
+//! Intersects hints
+BOOST_CONSTEXPR inline madvise_hints operator& (madvise_hints left, madvise_hints right) noexcept
+{
+    return static_cast< madvise_hints >(static_cast< unsigned int >(left) & static_cast< unsigned int >(right));
+}
+
+//! \cond
+namespace detail {
+
+//! Returns the \c madvise advice for the hint or -1 if it is not supported
+BOOST_CONSTEXPR inline int madvise_advice(madvise_hints hint) noexcept
+{
+    return
+#if defined(MADV_WILLNEED)
+        hint == madvise_hints::willneed ? MADV_WILLNEED :
+#endif
+#if defined(MADV_HUGEPAGE)
+        hint == madvise_hints::hugepage ? MADV_HUGEPAGE :
+#endif
+#if defined(MADV_NOHUGEPAGE)
+        hint == madvise_hints::nohugepage ? MADV_NOHUGEPAGE :
+#endif
+#if defined(MADV_COLD)
+        hint == madvise_hints::cold ? MADV_COLD :
+#endif
+#if defined(MADV_PAGEOUT)
+        hint == madvise_hints::pageout ? MADV_PAGEOUT :
+#endif
+#if defined(MADV_DONTNEED)
+        hint == madvise_hints::dontneed ? MADV_DONTNEED :
+#endif
+        -1;
+}
+
+//! Applies the hints to the memory region, returns the error code of the first failed hint or 0
+inline int apply_madvise_hints(void* addr, std::size_t size, madvise_hints hints) noexcept
+{
+    int err = 0;
+    for (unsigned int bits = static_cast< unsigned int >(hints); bits != 0u; bits &= bits - 1u)
+    {
+        const int advice = madvise_advice(static_cast< madvise_hints >(bits & (~bits + 1u)));
+        if (BOOST_UNLIKELY(advice < 0))
+        {
+            if (err == 0)
+                err = ENOTSUP;
+            continue;
+        }
+
+        if (BOOST_UNLIKELY(::madvise(addr, size, advice) != 0) && err == 0)
+            err = errno;
+    }
+
+    return err;
+}
+
+//! Scope guard action that applies hints to a memory region
+class madvise_action
+{
+private:
+    void* m_addr;
+    std::size_t m_size;
+    madvise_hints m_hints;
+
+public:
+    madvise_action(void* addr, std::size_t size, madvise_hints hints) noexcept :
+        m_addr(addr),
+        m_size(size),
+        m_hints(hints)
+    {
+    }
+
+    void operator() () const noexcept
+    {
+        apply_madvise_hints(m_addr, m_size, m_hints);
+    }
+};
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Scope guard that applies memory residency hints to a memory region on scope entry and exit.
+ *
+ * On construction, the scope guard applies the entry hints to the memory region, for example, to prefetch
+ * the region and enable transparent huge pages for it. On destruction, if the scope guard is active, it applies
+ * the exit hints, for example, to let the system reclaim the region pages. The exit hints are applied regardless
+ * of whether the scope is left normally or due to an exception.
+ *
+ * The hints are passed to \c madvise. The region address must be aligned to the page size. The system applies
+ * the hints to whole pages, so the region size should be a multiple of the page size if the hints may discard
+ * the region contents (e.g. \c madvise_hints::dontneed). Errors reported by \c madvise on scope exit are ignored,
+ * as the hints are advisory.
+ *
+ * The memory region must remain mapped until the scope guard is destroyed or deactivated.
+ */
+class madvise_scope :
+    public scope_exit< detail::madvise_action >
+{
+//! \cond
+private:
+    using base_type = scope_exit< detail::madvise_action >;
+
+//! \endcond
+public:
+    /*!
+     * \brief Applies the entry hints to the memory region.
+     *
+     * **Effects:** Applies \a enter_hints to the memory region. Errors are ignored.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param addr Address of the memory region. Must be aligned to the page size.
+     * \param size Size of the memory region, in bytes.
+     * \param enter_hints Hints to apply on construction.
+     * \param exit_hints Hints to apply on scope exit.
+     * \param active Indicates whether the scope guard should be active upon construction. The entry hints are applied
+     *               regardless of this argument.
+     *
+     * \post `this->active() == active`
+     */
+    madvise_scope(void* addr, std::size_t size, madvise_hints enter_hints, madvise_hints exit_hints, bool active = true) noexcept :
+        base_type(detail::madvise_action(addr, size, exit_hints), active)
+    {
+        detail::apply_madvise_hints(addr, size, enter_hints);
+    }
+
+    /*!
+     * \brief Applies the entry hints to the memory region.
+     *
+     * **Effects:** Applies \a enter_hints to the memory region. Regardless of errors, the scope guard is constructed
+     *              with \a exit_hints.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param addr Address of the memory region. Must be aligned to the page size.
+     * \param size Size of the memory region, in bytes.
+     * \param enter_hints Hints to apply on construction.
+     * \param exit_hints Hints to apply on scope exit.
+     * \param ec Error code. Cleared if all entry hints were applied and set to the error reported by the system for
+     *           the first hint that failed otherwise. If a hint is not supported on the target system, set to
+     *           \c std::errc::not_supported.
+     * \param active Indicates whether the scope guard should be active upon construction. The entry hints are applied
+     *               regardless of this argument.
+     *
+     * \post `this->active() == active`
+     */
+    madvise_scope(void* addr, std::size_t size, madvise_hints enter_hints, madvise_hints exit_hints, std::error_code& ec, bool active = true) noexcept :
+        base_type(detail::madvise_action(addr, size, exit_hints), active)
+    {
+        const int err = detail::apply_madvise_hints(addr, size, enter_hints);
+        if (BOOST_LIKELY(err == 0))
+            ec.clear();
+        else
+            ec = std::error_code(err, std::generic_category());
+    }
+
+    /*!
+     * \brief Move-constructs a scope guard.
+     *
+     * **Effects:** If \a that is active, the constructed scope guard becomes responsible for applying
+     *              the exit hints and \a that becomes inactive. Otherwise, the constructed scope guard is inactive.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param that Move source.
+     */
+    madvise_scope(madvise_scope&& that) = default;
+
+    madvise_scope& operator= (madvise_scope&&) = delete;
+    madvise_scope(madvise_scope const&) = delete;
+    madvise_scope& operator= (madvise_scope const&) = delete;
+};
+
+//! \cond
+template< >
+struct is_trivially_relocatable< madvise_scope > :
+    public std::true_type
+{
+};
+//! \endcond
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // !defined(BOOST_WINDOWS)
+
+#endif // BOOST_SCOPE_MADVISE_SCOPE_HPP_INCLUDED_
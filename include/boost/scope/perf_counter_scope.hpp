@@ -0,0 +1,451 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/perf_counter_scope.hpp
+ *
+ * This header contains definition of \c perf_counter_scope scope guard, which measures
+ * hardware or software performance counters within a scope.
+ *
+ * The components are only available on Linux.
+ */
+
+#ifndef BOOST_SCOPE_PERF_COUNTER_SCOPE_HPP_INCLUDED_
+#define BOOST_SCOPE_PERF_COUNTER_SCOPE_HPP_INCLUDED_
+
+#include <boost/scope/detail/config.hpp>
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <boost/scope/defer.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/fd_factories.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+//! Source of performance counter values
+enum class perf_counter_source : unsigned int
+{
+    //! Performance counters are not available
+    none = 0u,
+    //! Hardware counters: \c cycles, \c instructions, \c cache_misses and \c branch_misses
+    hardware,
+    //! Software counters: \c task_clock, \c page_faults and \c context_switches
+    software
+};
+
+/*!
+ * \brief Accumulated performance counter values.
+ *
+ * Depending on \c source, either hardware or software counter values are collected, the other values are zero.
+ * Hardware counters only measure events in user space. Software counters include events in the kernel, if the process
+ * is allowed to measure the kernel. Otherwise, task clock and page faults only measure user space, and context switches
+ * are obtained with \c getrusage. If the counters were multiplexed with other counters by the kernel, the values are scaled
+ * to the time the counters were enabled.
+ */
+struct perf_counter_values
+{
+    //! Source of the counter values
+    perf_counter_source source;
+    //! Number of measured scopes
+    std::uint64_t scopes;
+
+    //! CPU cycles
+    std::uint64_t cycles;
+    //! Retired instructions
+    std::uint64_t instructions;
+    //! Last level cache misses
+    std::uint64_t cache_misses;
+    //! Mispredicted branches
+    std::uint64_t branch_misses;
+
+    //! Task clock, in nanoseconds
+    std::uint64_t task_clock;
+    //! Page faults
+    std::uint64_t page_faults;
+    //! Context switches
+    std::uint64_t context_switches;
+};
+
+//! \cond
+namespace detail {
+
+//! Snapshot of the counter group values
+struct perf_counter_snapshot
+{
+    std::uint64_t time_enabled;
+    std::uint64_t time_running;
+    std::uint64_t values[4u];
+};
+
+//! Group of performance counters of the current thread
+class perf_counter_group
+{
+public:
+    static BOOST_CONSTEXPR_OR_CONST std::size_t max_counters = 4u;
+
+private:
+    unique_fd m_fds[max_counters];
+    std::size_t m_count;
+    perf_counter_source m_source;
+    bool m_initialized;
+    //! Indicates that context switches are obtained with \c getrusage rather than a counter
+    bool m_rusage_context_switches;
+    perf_counter_values m_results;
+
+public:
+    perf_counter_group() noexcept :
+        m_count(0u),
+        m_source(perf_counter_source::none),
+        m_initialized(false),
+        m_rusage_context_switches(false),
+        m_results()
+    {
+    }
+
+    perf_counter_group(perf_counter_group const&) = delete;
+    perf_counter_group& operator= (perf_counter_group const&) = delete;
+
+    perf_counter_values& results() noexcept
+    {
+        return m_results;
+    }
+
+    //! Returns the counter source, opens the counters on the first call
+    perf_counter_source source() noexcept
+    {
+        if (BOOST_UNLIKELY(!m_initialized))
+            init();
+        return m_source;
+    }
+
+    //! Reads the counter values, returns \c false on failure
+    bool read(perf_counter_snapshot& snapshot) const noexcept
+    {
+        // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, values[nr]
+        std::uint64_t buf[3u + max_counters];
+        const std::size_t size = (3u + m_count) * sizeof(std::uint64_t);
+        while (true)
+        {
+            const ssize_t res = ::read(m_fds[0].get(), buf, size);
+            if (BOOST_LIKELY(res == static_cast< ssize_t >(size)))
+                break;
+            if (res >= 0 || errno != EINTR)
+                return false;
+        }
+
+        snapshot.time_enabled = buf[1];
+        snapshot.time_running = buf[2];
+        for (std::size_t i = 0u; i < m_count; ++i)
+            snapshot.values[i] = buf[3u + i];
+
+        if (m_rusage_context_switches)
+        {
+#if defined(RUSAGE_THREAD)
+            struct rusage ru = {};
+            if (BOOST_UNLIKELY(::getrusage(RUSAGE_THREAD, &ru) != 0))
+                return false;
+            snapshot.values[m_count] = static_cast< std::uint64_t >(ru.ru_nvcsw) + static_cast< std::uint64_t >(ru.ru_nivcsw);
+#else
+            snapshot.values[m_count] = 0u;
+#endif
+        }
+
+        return true;
+    }
+
+    //! Adds the difference between the snapshots to the results
+    void accumulate(perf_counter_snapshot const& start, perf_counter_snapshot const& end, perf_counter_values& results) const noexcept
+    {
+        const std::uint64_t enabled = end.time_enabled - start.time_enabled;
+        const std::uint64_t running = end.time_running - start.time_running;
+        std::uint64_t deltas[max_counters];
+        for (std::size_t i = 0u; i < m_count; ++i)
+        {
+            std::uint64_t delta = end.values[i] - start.values[i];
+            if (BOOST_UNLIKELY(running < enabled))
+            {
+                // The counters were multiplexed, extrapolate to the time they were enabled
+                delta = running > 0u ? static_cast< std::uint64_t >(static_cast< double >(delta) * static_cast< double >(enabled) / static_cast< double >(running)) : 0u;
+            }
+            deltas[i] = delta;
+        }
+
+        if (m_rusage_context_switches)
+            deltas[m_count] = end.values[m_count] - start.values[m_count];
+
+        results.source = m_source;
+        ++results.scopes;
+        if (m_source == perf_counter_source::hardware)
+        {
+            results.cycles += deltas[0];
+            results.instructions += deltas[1];
+            results.cache_misses += deltas[2];
+            results.branch_misses += deltas[3];
+        }
+        else
+        {
+            results.task_clock += deltas[0];
+            results.page_faults += deltas[1];
+            results.context_switches += deltas[2];
+        }
+    }
+
+private:
+    void init() noexcept
+    {
+        m_initialized = true;
+
+        static const std::uint64_t hardware_events[] =
+        {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+        };
+        if (open_group(PERF_TYPE_HARDWARE, hardware_events, sizeof(hardware_events) / sizeof(*hardware_events), true))
+        {
+            m_source = perf_counter_source::hardware;
+            return;
+        }
+
+        // Hardware counters may be unavailable, e.g. in virtual machines or due to access restrictions
+        static const std::uint64_t software_events[] =
+        {
+            PERF_COUNT_SW_TASK_CLOCK,
+            PERF_COUNT_SW_PAGE_FAULTS,
+            PERF_COUNT_SW_CONTEXT_SWITCHES
+        };
+        // Context switches are only counted in kernel mode, so try to include the kernel first
+        if (open_group(PERF_TYPE_SOFTWARE, software_events, sizeof(software_events) / sizeof(*software_events), false))
+        {
+            m_source = perf_counter_source::software;
+            return;
+        }
+
+        // If measuring the kernel is not allowed (perf_event_paranoid > 1), count context switches with getrusage
+        if (open_group(PERF_TYPE_SOFTWARE, software_events, sizeof(software_events) / sizeof(*software_events) - 1u, true))
+        {
+            m_source = perf_counter_source::software;
+            m_rusage_context_switches = true;
+        }
+    }
+
+    bool open_group(std::uint32_t type, const std::uint64_t* events, std::size_t count, bool exclude_kernel) noexcept
+    {
+#if defined(SYS_perf_event_open)
+#if defined(PERF_FLAG_FD_CLOEXEC)
+        const unsigned long flags = PERF_FLAG_FD_CLOEXEC;
+#else
+        const unsigned long flags = 8ul;
+#endif
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            struct perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = events[i];
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attr.exclude_kernel = exclude_kernel;
+            attr.exclude_hv = 1;
+
+            const int group_fd = i > 0u ? m_fds[0].get() : -1;
+            std::error_code ec;
+            m_fds[i] = detail::make_unique_fd(static_cast< int >(::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, flags)), ec);
+            if (BOOST_UNLIKELY(!!ec))
+            {
+                for (std::size_t j = 0u; j < i; ++j)
+                    m_fds[j].reset();
+                return false;
+            }
+        }
+
+        m_count = count;
+        return true;
+#else
+        static_cast< void >(type);
+        static_cast< void >(events);
+        static_cast< void >(count);
+        static_cast< void >(exclude_kernel);
+        return false;
+#endif
+    }
+};
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+//! Returns the performance counter group of the current thread
+inline perf_counter_group* get_thread_perf_counter_group() noexcept
+{
+    static thread_local perf_counter_group group;
+    return &group;
+}
+
+#else // !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+inline perf_counter_group* get_thread_perf_counter_group() noexcept
+{
+    return nullptr;
+}
+
+#endif // !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+//! Scope exit action that accumulates counter deltas
+class perf_counter_end_action
+{
+private:
+    perf_counter_group* m_group;
+    perf_counter_values* m_results;
+    perf_counter_snapshot m_start;
+
+public:
+    explicit perf_counter_end_action(perf_counter_values* results) noexcept :
+        m_group(detail::get_thread_perf_counter_group()),
+        m_results(results)
+    {
+        if (BOOST_LIKELY(m_group != nullptr))
+        {
+            if (m_results == nullptr)
+                m_results = &m_group->results();
+
+            if (BOOST_UNLIKELY(m_group->source() == perf_counter_source::none || !m_group->read(m_start)))
+                m_group = nullptr;
+        }
+    }
+
+    void operator() () const noexcept
+    {
+        if (BOOST_LIKELY(m_group != nullptr))
+        {
+            perf_counter_snapshot end;
+            if (BOOST_LIKELY(m_group->read(end)))
+                m_group->accumulate(m_start, end, *m_results);
+        }
+    }
+};
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Scope guard that measures performance counters within a scope.
+ *
+ * On construction, the scope guard reads the performance counters of the current thread. On destruction,
+ * it reads the counters again and adds the differences to the result slot, which by default is the slot of
+ * the current thread returned by \c this_thread_perf_counters.
+ *
+ * The counters are opened with \c perf_event_open as a group on the first use in a thread and are owned by
+ * that thread through \c unique_fd. The counters remain open and are reused by subsequent scope guards in that
+ * thread, so that a scope guard only performs one \c read system call on entry and one on exit. The counters
+ * are closed when the thread terminates.
+ *
+ * If hardware counters (CPU cycles, instructions, cache misses and branch misses) are not available, for example,
+ * in a virtual machine or due to access restrictions, software counters (task clock, page faults and context switches)
+ * are used instead. If no counters are available, the scope guard does nothing. Hardware counters only measure events
+ * in user space. Context switches happen in the kernel, so if the process is not allowed to measure the kernel, they
+ * are obtained with \c getrusage, which costs an additional system call on scope entry and exit.
+ */
+class perf_counter_scope :
+    public defer_guard< detail::perf_counter_end_action >
+{
+//! \cond
+private:
+    using base_type = defer_guard< detail::perf_counter_end_action >;
+
+//! \endcond
+public:
+    /*!
+     * \brief Starts measuring performance counters.
+     *
+     * **Effects:** Reads the counters of the current thread, opening them if this is the first use in the thread.
+     *              On scope exit, the counter differences are added to the slot of the current thread.
+     *
+     * **Throws:** Nothing.
+     */
+    perf_counter_scope() noexcept :
+        base_type(detail::perf_counter_end_action(nullptr))
+    {
+    }
+
+    /*!
+     * \brief Starts measuring performance counters.
+     *
+     * **Effects:** Reads the counters of the current thread, opening them if this is the first use in the thread.
+     *              On scope exit, the counter differences are added to \a results.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param results Result slot. Must remain valid until the scope guard is destroyed.
+     */
+    explicit perf_counter_scope(perf_counter_values& results) noexcept :
+        base_type(detail::perf_counter_end_action(&results))
+    {
+    }
+
+    perf_counter_scope(perf_counter_scope const&) = delete;
+    perf_counter_scope& operator= (perf_counter_scope const&) = delete;
+};
+
+/*!
+ * \brief Returns the performance counter result slot of the current thread.
+ *
+ * The slot accumulates the counter values measured by \c perf_counter_scope guards in the current thread. The slot
+ * can be reset by assigning a value-initialized \c perf_counter_values to it.
+ *
+ * If \c thread_local is not supported by the compiler, returns a reference to a static slot, which is never updated.
+ *
+ * **Throws:** Nothing.
+ */
+inline perf_counter_values& this_thread_perf_counters() noexcept
+{
+    detail::perf_counter_group* group = detail::get_thread_perf_counter_group();
+    if (BOOST_LIKELY(group != nullptr))
+        return group->results();
+
+    static perf_counter_values dummy = {};
+    return dummy;
+}
+
+/*!
+ * \brief Returns the performance counter source of the current thread.
+ *
+ * **Effects:** Opens the performance counters of the current thread, if they are not open yet.
+ *
+ * **Throws:** Nothing.
+ */
+inline perf_counter_source this_thread_perf_counter_source() noexcept
+{
+    detail::perf_counter_group* group = detail::get_thread_perf_counter_group();
+    if (BOOST_LIKELY(group != nullptr))
+        return group->source();
+    return perf_counter_source::none;
+}
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // defined(__linux__)
+
+#endif // BOOST_SCOPE_PERF_COUNTER_SCOPE_HPP_INCLUDED_
@@ -0,0 +1,372 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/resource_leak_detector.hpp
+ *
+ * This header contains definition of \c resource_leak_detector instrumentation
+ * for \c unique_resource.
+ */
+
+#ifndef BOOST_SCOPE_RESOURCE_LEAK_DETECTOR_HPP_INCLUDED_
+#define BOOST_SCOPE_RESOURCE_LEAK_DETECTOR_HPP_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/scope/resource_site.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief Number of live resources acquired at a given source location.
+ */
+struct resource_leak_record
+{
+    //! Source location where the resources were acquired
+    resource_site site;
+    //! Number of live resources
+    std::size_t count;
+};
+
+namespace detail {
+
+//! Number of shards in \c resource_leak_detector
+BOOST_CONSTEXPR_OR_CONST std::size_t resource_leak_shard_count = 16u;
+
+//! Set of live resources in a single shard
+struct alignas(64) resource_leak_shard
+{
+    std::mutex mutex;
+    //! Maps addresses of \c unique_resource objects to sites where their resources were acquired
+    std::unordered_map< const void*, resource_site > live;
+};
+
+//! Compares resource sites for ordering
+inline int compare_resource_sites(resource_site const& left, resource_site const& right) noexcept
+{
+    if (left.file != right.file)
+    {
+        if (!left.file)
+            return -1;
+        if (!right.file)
+            return 1;
+        const int res = std::strcmp(left.file, right.file);
+        if (res != 0)
+            return res;
+    }
+
+    if (left.line != right.line)
+        return left.line < right.line ? -1 : 1;
+
+    if (left.function != right.function)
+    {
+        if (!left.function)
+            return -1;
+        if (!right.function)
+            return 1;
+        return std::strcmp(left.function, right.function);
+    }
+
+    return 0;
+}
+
+//! Registry of live resources
+class resource_leak_registry
+{
+private:
+    resource_leak_shard m_shards[resource_leak_shard_count];
+
+public:
+    void add(const void* owner, resource_site const& site) noexcept
+    {
+        resource_leak_shard& shard = get_shard(owner);
+        std::lock_guard< std::mutex > lock(shard.mutex);
+        BOOST_TRY
+        {
+            shard.live[owner] = site;
+        }
+        BOOST_CATCH (...)
+        {
+            // The resource will not be tracked if memory allocation fails
+        }
+        BOOST_CATCH_END
+    }
+
+    bool remove(const void* owner, resource_site& site) noexcept
+    {
+        resource_leak_shard& shard = get_shard(owner);
+        std::lock_guard< std::mutex > lock(shard.mutex);
+        auto it = shard.live.find(owner);
+        if (it == shard.live.end())
+            return false;
+
+        site = it->second;
+        shard.live.erase(it);
+        return true;
+    }
+
+    void remove(const void* owner) noexcept
+    {
+        resource_site site;
+        remove(owner, site);
+    }
+
+    std::size_t live_count() noexcept
+    {
+        std::size_t count = 0u;
+        for (std::size_t i = 0u; i < resource_leak_shard_count; ++i)
+        {
+            resource_leak_shard& shard = m_shards[i];
+            std::lock_guard< std::mutex > lock(shard.mutex);
+            count += shard.live.size();
+        }
+
+        return count;
+    }
+
+    std::vector< resource_leak_record > report()
+    {
+        std::vector< resource_site > sites;
+        for (std::size_t i = 0u; i < resource_leak_shard_count; ++i)
+        {
+            resource_leak_shard& shard = m_shards[i];
+            std::lock_guard< std::mutex > lock(shard.mutex);
+            sites.reserve(sites.size() + shard.live.size());
+            for (auto const& entry : shard.live)
+                sites.push_back(entry.second);
+        }
+
+        std::sort(sites.begin(), sites.end(), [](resource_site const& left, resource_site const& right)
+        {
+            return detail::compare_resource_sites(left, right) < 0;
+        });
+
+        std::vector< resource_leak_record > records;
+        for (std::size_t i = 0u, n = sites.size(); i < n;)
+        {
+            std::size_t j = i + 1u;
+            while (j < n && detail::compare_resource_sites(sites[i], sites[j]) == 0)
+                ++j;
+
+            resource_leak_record rec = { sites[i], j - i };
+            records.push_back(rec);
+            i = j;
+        }
+
+        std::stable_sort(records.begin(), records.end(), [](resource_leak_record const& left, resource_leak_record const& right)
+        {
+            return left.count > right.count;
+        });
+
+        return records;
+    }
+
+    void write_report(std::FILE* file)
+    {
+        std::vector< resource_leak_record > records = report();
+        for (resource_leak_record const& rec : records)
+        {
+            if (rec.site.known())
+            {
+                std::fprintf(file, "%s:%u: %s: %lu live resource(s)\n",
+                    rec.site.file, rec.site.line, rec.site.function ? rec.site.function : "",
+                    static_cast< unsigned long >(rec.count));
+            }
+            else
+            {
+                std::fprintf(file, "<unknown location>: %lu live resource(s)\n", static_cast< unsigned long >(rec.count));
+            }
+        }
+    }
+
+private:
+    resource_leak_shard& get_shard(const void* owner) noexcept
+    {
+        const std::uintptr_t addr = reinterpret_cast< std::uintptr_t >(owner);
+        return m_shards[((addr >> 4u) ^ (addr >> 12u)) % resource_leak_shard_count];
+    }
+};
+
+//! Returns the registry of live resources for the given tag
+template< typename Tag >
+inline resource_leak_registry& get_resource_leak_registry() noexcept
+{
+    static resource_leak_registry registry;
+    return registry;
+}
+
+} // namespace detail
+
+/*!
+ * \brief \c unique_resource instrumentation that tracks live resources for leak detection.
+ *
+ * The instrumentation registers every resource owned by a \c unique_resource object along with
+ * the source location where the resource was acquired. The source locations are only known
+ * if the location is passed to the \c unique_resource constructor or \c reset. The live resources can be
+ * reported on demand, grouped by the source location, or at the process exit.
+ *
+ * The instrumentation is intended for debug builds. It can be enabled for a \c unique_resource
+ * type by specifying it as the nested \c instrumentation type in the resource traits:
+ *
+ * ```
+ * struct tracked_fd_traits : public boost::scope::fd_resource_traits
+ * {
+ *     using instrumentation = boost::scope::resource_leak_detector< tracked_fd_traits >;
+ * };
+ *
+ * using tracked_unique_fd = boost::scope::unique_resource< int, boost::scope::fd_deleter, tracked_fd_traits >;
+ * ```
+ *
+ * The set of live resources is split into shards, each protected by a mutex, which reduces
+ * contention between threads.
+ *
+ * \tparam Tag Tag type that allows to maintain separate sets of live resources for different resource types.
+ */
+template< typename Tag >
+class resource_leak_detector
+{
+public:
+    //! Registers the resource with an unknown source location
+    template< typename Resource >
+    static void on_acquire(const void* owner, Resource const&) noexcept
+    {
+        detail::get_resource_leak_registry< Tag >().add(owner, resource_site());
+    }
+
+    //! Registers the resource with the source location
+    template< typename Resource >
+    static void on_acquire(const void* owner, Resource const&, resource_site const& site) noexcept
+    {
+        detail::get_resource_leak_registry< Tag >().add(owner, site);
+    }
+
+    //! Unregisters the resource
+    template< typename Resource >
+    static void on_release(const void* owner, Resource const&) noexcept
+    {
+        detail::get_resource_leak_registry< Tag >().remove(owner);
+    }
+
+    //! Unregisters the resource
+    template< typename Resource >
+    static void on_reset(const void* owner, Resource const&) noexcept
+    {
+        detail::get_resource_leak_registry< Tag >().remove(owner);
+    }
+
+    //! Transfers the resource registration between \c unique_resource objects
+    template< typename Resource >
+    static void on_move(const void* from, const void* to, Resource const&) noexcept
+    {
+        detail::resource_leak_registry& registry = detail::get_resource_leak_registry< Tag >();
+        resource_site site;
+        if (registry.remove(from, site))
+            registry.add(to, site);
+    }
+
+    //! Exchanges resource registrations between \c unique_resource objects
+    static void on_swap(const void* left, const void* right) noexcept
+    {
+        detail::resource_leak_registry& registry = detail::get_resource_leak_registry< Tag >();
+        resource_site left_site, right_site;
+        const bool left_live = registry.remove(left, left_site);
+        const bool right_live = registry.remove(right, right_site);
+        if (left_live)
+            registry.add(right, left_site);
+        if (right_live)
+            registry.add(left, right_site);
+    }
+
+    /*!
+     * \brief Returns the number of live resources.
+     *
+     * **Throws:** Nothing.
+     */
+    static std::size_t live_count() noexcept
+    {
+        return detail::get_resource_leak_registry< Tag >().live_count();
+    }
+
+    /*!
+     * \brief Returns the live resources, grouped by the source location where they were acquired.
+     *
+     * The returned records are ordered by the number of live resources, in descending order.
+     *
+     * **Throws:** \c std::bad_alloc if memory allocation fails.
+     */
+    static std::vector< resource_leak_record > report()
+    {
+        return detail::get_resource_leak_registry< Tag >().report();
+    }
+
+    /*!
+     * \brief Writes a human-readable report of the live resources to the file.
+     *
+     * **Throws:** \c std::bad_alloc if memory allocation fails.
+     */
+    static void write_report(std::FILE* file)
+    {
+        detail::get_resource_leak_registry< Tag >().write_report(file);
+    }
+
+    /*!
+     * \brief Requests a report of live resources to be written to \c stderr at the process exit.
+     *
+     * The report is written by a function registered with \c std::atexit. The report only
+     * includes resources that are still live at that point. Calling this function multiple
+     * times has no additional effect.
+     *
+     * **Throws:** Nothing.
+     *
+     * \returns \c true if the report function was successfully registered, otherwise \c false.
+     */
+    static bool report_at_exit() noexcept
+    {
+        // Make sure the registry is constructed before the atexit function is registered
+        detail::get_resource_leak_registry< Tag >();
+        static const bool registered = std::atexit(&resource_leak_detector::write_exit_report) == 0;
+        return registered;
+    }
+
+//! \cond
+private:
+    static void write_exit_report()
+    {
+        BOOST_TRY
+        {
+            write_report(stderr);
+        }
+        BOOST_CATCH (...)
+        {
+        }
+        BOOST_CATCH_END
+    }
+//! \endcond
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_RESOURCE_LEAK_DETECTOR_HPP_INCLUDED_
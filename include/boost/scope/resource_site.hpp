@@ -0,0 +1,116 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/resource_site.hpp
+ *
+ * This header contains definition of \c resource_site type.
+ */
+
+#ifndef BOOST_SCOPE_RESOURCE_SITE_HPP_INCLUDED_
+#define BOOST_SCOPE_RESOURCE_SITE_HPP_INCLUDED_
+
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+//! \cond
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_FILE) && __has_builtin(__builtin_LINE) && __has_builtin(__builtin_FUNCTION)
+#define BOOST_SCOPE_DETAIL_HAS_BUILTIN_SOURCE_LOCATION
+#endif
+#endif
+#if !defined(BOOST_SCOPE_DETAIL_HAS_BUILTIN_SOURCE_LOCATION) && \
+    ((defined(BOOST_GCC) && BOOST_GCC >= 40800) || (defined(BOOST_MSVC) && BOOST_MSVC >= 1926))
+#define BOOST_SCOPE_DETAIL_HAS_BUILTIN_SOURCE_LOCATION
+#endif
+//! \endcond
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief Source code location where a resource was acquired.
+ *
+ * The location can be passed to \c unique_resource constructors and \c reset, which pass it
+ * to the instrumentation. If the compiler does not support capturing the source location, or
+ * the location was not passed, \c file and \c function are null pointers and \c line is zero.
+ */
+struct resource_site
+{
+    //! Source file name
+    const char* file;
+    //! Function name
+    const char* function;
+    //! Line number
+    unsigned int line;
+
+    /*!
+     * \brief Constructs an unknown source location.
+     *
+     * **Throws:** Nothing.
+     */
+    constexpr resource_site() noexcept :
+        file(nullptr),
+        function(nullptr),
+        line(0u)
+    {
+    }
+
+    /*!
+     * \brief Constructs a source location from the given components.
+     *
+     * **Throws:** Nothing.
+     */
+    constexpr resource_site(const char* file_name, unsigned int line_number, const char* function_name) noexcept :
+        file(file_name),
+        function(function_name),
+        line(line_number)
+    {
+    }
+
+    /*!
+     * \brief Returns the location of the call site.
+     *
+     * When called with no arguments in a default function argument, returns the location of the
+     * caller of the function.
+     *
+     * **Throws:** Nothing.
+     */
+#if defined(BOOST_SCOPE_DETAIL_HAS_BUILTIN_SOURCE_LOCATION)
+    static constexpr resource_site current
+    (
+        const char* file_name = __builtin_FILE(),
+        unsigned int line_number = __builtin_LINE(),
+        const char* function_name = __builtin_FUNCTION()
+    ) noexcept
+    {
+        return resource_site(file_name, line_number, function_name);
+    }
+#else
+    static constexpr resource_site current() noexcept
+    {
+        return resource_site();
+    }
+#endif
+
+    //! Returns \c true if the location is known
+    constexpr bool known() const noexcept
+    {
+        return file != nullptr;
+    }
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_RESOURCE_SITE_HPP_INCLUDED_
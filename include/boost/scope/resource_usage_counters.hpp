@@ -0,0 +1,295 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/resource_usage_counters.hpp
+ *
+ * This header contains definition of \c resource_usage_counters instrumentation
+ * for \c unique_resource.
+ */
+
+#ifndef BOOST_SCOPE_RESOURCE_USAGE_COUNTERS_HPP_INCLUDED_
+#define BOOST_SCOPE_RESOURCE_USAGE_COUNTERS_HPP_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+//! \c unique_resource instrumentation event
+enum class resource_event
+{
+    //! The resource was acquired by a \c unique_resource object
+    acquire,
+    //! The resource was released from a \c unique_resource object without calling the deleter
+    release,
+    //! The resource is about to be freed by calling the deleter
+    reset,
+    //! The resource was moved between \c unique_resource objects
+    move,
+    //! Two \c unique_resource objects have swapped their resources
+    swap
+};
+
+/*!
+ * \brief Snapshot of resource usage counters.
+ */
+struct resource_usage_snapshot
+{
+    //! Number of resources acquired
+    std::uint64_t acquired;
+    //! Number of resources released without calling the deleter
+    std::uint64_t released;
+    //! Number of resources freed by calling the deleter
+    std::uint64_t reset;
+    //! Number of resource moves between \c unique_resource objects
+    std::uint64_t moved;
+    //! Number of currently live resources
+    std::uint64_t live;
+    /*!
+     * Maximum number of live resources observed by \c snapshot calls since the counters were cleared.
+     * The number of live resources is sampled when a snapshot is taken, so peaks between snapshots
+     * are not reflected.
+     */
+    std::uint64_t high_water_mark;
+};
+
+namespace detail {
+
+//! Number of counter shards in \c resource_usage_counters
+BOOST_CONSTEXPR_OR_CONST std::size_t resource_usage_shard_count = 16u;
+
+//! Returns the counter shard index for the current thread
+inline std::size_t get_resource_usage_shard_index() noexcept
+{
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+    static std::atomic< std::size_t > next_index{ 0u };
+    static thread_local const std::size_t index = next_index.fetch_add(1u, std::memory_order_relaxed) % resource_usage_shard_count;
+    return index;
+#else
+    return 0u;
+#endif
+}
+
+//! Resource usage counters of a single shard
+struct alignas(64) resource_usage_shard
+{
+    std::atomic< std::uint64_t > acquired;
+    std::atomic< std::uint64_t > released;
+    std::atomic< std::uint64_t > reset;
+    std::atomic< std::uint64_t > moved;
+    // Note: can go negative if resources are acquired and freed in different threads
+    std::atomic< std::int64_t > live;
+};
+
+//! Maximum number of live resources, across all shards
+struct alignas(64) resource_usage_high_water_mark
+{
+    std::atomic< std::int64_t > value;
+};
+
+} // namespace detail
+
+/*!
+ * \brief \c unique_resource instrumentation that collects resource usage statistics.
+ *
+ * The instrumentation can be enabled for a \c unique_resource type by specifying it as the
+ * nested \c instrumentation type in the resource traits. For example:
+ *
+ * ```
+ * struct instrumented_fd_traits : public boost::scope::fd_resource_traits
+ * {
+ *     using instrumentation = boost::scope::resource_usage_counters< instrumented_fd_traits >;
+ * };
+ *
+ * using instrumented_unique_fd = boost::scope::unique_resource< int, boost::scope::fd_deleter, instrumented_fd_traits >;
+ * ```
+ *
+ * The counters are kept in per-thread shards, which allows to avoid contention between threads
+ * when updating the counters. The counters can be read with \c snapshot. The high-water mark
+ * of live resources is sampled at snapshot time, so that resource events do not update
+ * any data shared between threads. Additionally, the user
+ * may install a hook function that will be called on every resource event.
+ *
+ * \tparam Tag Tag type that allows to maintain separate counters for different resource types.
+ */
+template< typename Tag >
+class resource_usage_counters
+{
+public:
+    //! Event hook function type
+    using event_hook = void (*)(resource_event event, const void* owner);
+
+//! \cond
+private:
+    static detail::resource_usage_shard* get_shards() noexcept
+    {
+        static detail::resource_usage_shard shards[detail::resource_usage_shard_count];
+        return shards;
+    }
+
+    static detail::resource_usage_shard& get_shard() noexcept
+    {
+        return get_shards()[detail::get_resource_usage_shard_index()];
+    }
+
+    static std::atomic< std::int64_t >& get_high_water_mark() noexcept
+    {
+        static detail::resource_usage_high_water_mark high_water_mark;
+        return high_water_mark.value;
+    }
+
+    static std::atomic< event_hook >& get_event_hook() noexcept
+    {
+        static std::atomic< event_hook > hook{ nullptr };
+        return hook;
+    }
+
+    static void invoke_event_hook(resource_event event, const void* owner) noexcept
+    {
+        event_hook hook = get_event_hook().load(std::memory_order_acquire);
+        if (BOOST_UNLIKELY(hook != nullptr))
+            hook(event, owner);
+    }
+
+//! \endcond
+public:
+    /*!
+     * \brief Installs a new event hook.
+     *
+     * The hook will be called on every event of every \c unique_resource object
+     * that uses this instrumentation. The hook must not throw exceptions.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param hook Pointer to the hook function. Can be \c nullptr to uninstall the hook.
+     * \returns Previously installed hook.
+     */
+    static event_hook set_event_hook(event_hook hook) noexcept
+    {
+        return get_event_hook().exchange(hook, std::memory_order_acq_rel);
+    }
+
+    /*!
+     * \brief Returns a snapshot of the counters.
+     *
+     * The counters of all thread shards are summed up. The high-water mark is updated
+     * with the current number of live resources. The snapshot is not atomic with
+     * respect to concurrent resource events.
+     *
+     * **Throws:** Nothing.
+     */
+    static resource_usage_snapshot snapshot() noexcept
+    {
+        resource_usage_snapshot snap = {};
+        std::int64_t live = 0;
+        detail::resource_usage_shard* shards = get_shards();
+        for (std::size_t i = 0u; i < detail::resource_usage_shard_count; ++i)
+        {
+            detail::resource_usage_shard& shard = shards[i];
+            snap.acquired += shard.acquired.load(std::memory_order_relaxed);
+            snap.released += shard.released.load(std::memory_order_relaxed);
+            snap.reset += shard.reset.load(std::memory_order_relaxed);
+            snap.moved += shard.moved.load(std::memory_order_relaxed);
+            live += shard.live.load(std::memory_order_relaxed);
+        }
+
+        std::atomic< std::int64_t >& max_live = get_high_water_mark();
+        std::int64_t high_water_mark = max_live.load(std::memory_order_relaxed);
+        while (live > high_water_mark)
+        {
+            if (max_live.compare_exchange_weak(high_water_mark, live, std::memory_order_relaxed, std::memory_order_relaxed))
+            {
+                high_water_mark = live;
+                break;
+            }
+        }
+
+        snap.live = live > 0 ? static_cast< std::uint64_t >(live) : 0u;
+        snap.high_water_mark = high_water_mark > live ? static_cast< std::uint64_t >(high_water_mark) : snap.live;
+        return snap;
+    }
+
+    /*!
+     * \brief Resets all counters to zero.
+     *
+     * The operation is not atomic with respect to concurrent resource events.
+     *
+     * **Throws:** Nothing.
+     */
+    static void clear() noexcept
+    {
+        detail::resource_usage_shard* shards = get_shards();
+        for (std::size_t i = 0u; i < detail::resource_usage_shard_count; ++i)
+        {
+            detail::resource_usage_shard& shard = shards[i];
+            shard.acquired.store(0u, std::memory_order_relaxed);
+            shard.released.store(0u, std::memory_order_relaxed);
+            shard.reset.store(0u, std::memory_order_relaxed);
+            shard.moved.store(0u, std::memory_order_relaxed);
+            shard.live.store(0, std::memory_order_relaxed);
+        }
+
+        get_high_water_mark().store(0, std::memory_order_relaxed);
+    }
+
+    //! \cond
+    template< typename Resource >
+    static void on_acquire(const void* owner, Resource const&) noexcept
+    {
+        detail::resource_usage_shard& shard = get_shard();
+        shard.acquired.fetch_add(1u, std::memory_order_relaxed);
+        shard.live.fetch_add(1, std::memory_order_relaxed);
+        invoke_event_hook(resource_event::acquire, owner);
+    }
+
+    template< typename Resource >
+    static void on_release(const void* owner, Resource const&) noexcept
+    {
+        detail::resource_usage_shard& shard = get_shard();
+        shard.released.fetch_add(1u, std::memory_order_relaxed);
+        shard.live.fetch_sub(1, std::memory_order_relaxed);
+        invoke_event_hook(resource_event::release, owner);
+    }
+
+    template< typename Resource >
+    static void on_reset(const void* owner, Resource const&) noexcept
+    {
+        detail::resource_usage_shard& shard = get_shard();
+        shard.reset.fetch_add(1u, std::memory_order_relaxed);
+        shard.live.fetch_sub(1, std::memory_order_relaxed);
+        invoke_event_hook(resource_event::reset, owner);
+    }
+
+    template< typename Resource >
+    static void on_move(const void*, const void* to, Resource const&) noexcept
+    {
+        get_shard().moved.fetch_add(1u, std::memory_order_relaxed);
+        invoke_event_hook(resource_event::move, to);
+    }
+
+    static void on_swap(const void* left, const void*) noexcept
+    {
+        invoke_event_hook(resource_event::swap, left);
+    }
+    //! \endcond
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_RESOURCE_USAGE_COUNTERS_HPP_INCLUDED_
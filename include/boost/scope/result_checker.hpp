@@ -0,0 +1,112 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/result_checker.hpp
+ *
+ * This header contains definition of \c result_checker type.
+ */
+
+#ifndef BOOST_SCOPE_RESULT_CHECKER_HPP_INCLUDED_
+#define BOOST_SCOPE_RESULT_CHECKER_HPP_INCLUDED_
+
+#include <type_traits>
+#include <boost/core/addressof.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/cold_action.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief A predicate for checking whether a result object holds an error.
+ *
+ * The predicate captures a reference to an external result object, which it tests
+ * for an error when called. The result object must remain valid for the whole lifetime
+ * duration of the predicate.
+ *
+ * For a result object `r`, an expression `r.has_value()` must be valid, never throw exceptions,
+ * and return a value contextually convertible to `bool`. If the returned value converts
+ * to `false`, then this is taken as an error indication, and the predicate returns `true`.
+ * Otherwise, the predicate returns `false`.
+ *
+ * A few examples of result types:
+ *
+ * \li `std::expected`,
+ * \li `boost::system::result`,
+ * \li `boost::outcome_v2::basic_result` or `boost::outcome_v2::basic_outcome`.
+ *
+ * \tparam Result Result type.
+ */
+template< typename Result >
+class result_checker
+{
+public:
+    //! Predicate result type
+    using result_type = bool;
+
+private:
+    Result* m_result;
+
+public:
+    /*!
+     * \brief Constructs the predicate.
+     *
+     * Upon construction, the predicate saves a reference to the external result object.
+     * The referenced object must remain valid for the whole lifetime duration of the predicate.
+     *
+     * **Throws:** Nothing.
+     */
+    explicit result_checker(Result& r) noexcept :
+        m_result(boost::addressof(r))
+    {
+    }
+
+    /*!
+     * \brief Checks if the result object holds an error.
+     *
+     * **Throws:** Nothing.
+     *
+     * \returns As if `!r.has_value()`, where `r` is the result object passed to the predicate constructor.
+     */
+    result_type operator()() const noexcept
+    {
+        return !m_result->has_value();
+    }
+};
+
+/*!
+ * \brief Creates a predicate for checking whether a result object holds an error
+ *
+ * **Throws:** Nothing.
+ */
+template< typename Result >
+inline result_checker< Result > check_result(Result& r) noexcept
+{
+    return result_checker< Result >(r);
+}
+
+//! \cond
+namespace detail {
+
+template< typename Result >
+struct is_failure_condition< result_checker< Result > > : public std::true_type { };
+
+} // namespace detail
+//! \endcond
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_RESULT_CHECKER_HPP_INCLUDED_
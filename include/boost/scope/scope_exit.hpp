@@ -16,7 +16,9 @@
 
 #include <type_traits>
 #include <boost/scope/detail/config.hpp>
+#include <boost/scope/is_trivially_relocatable.hpp>
 #include <boost/scope/detail/is_not_like.hpp>
+#include <boost/scope/detail/cold_action.hpp>
 #include <boost/scope/detail/compact_storage.hpp>
 #include <boost/scope/detail/move_or_copy_construct_ref.hpp>
 #include <boost/scope/detail/is_nonnull_default_constructible.hpp>
@@ -148,7 +150,8 @@ public:
  * \tparam Cond Scope guard condition function object type.
  */
 template< typename Func, typename Cond = always_true >
-class scope_exit
+class BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(detail::conjunction< is_trivially_relocatable< Func >, is_trivially_relocatable< Cond > >::value)
+scope_exit
 {
 //! \cond
 private:
@@ -450,8 +453,16 @@ public:
             >::value
         ))
     {
-        if (BOOST_LIKELY(m_data.m_active && m_data.get_cond()()))
-            m_data.get_func()();
+        if (detail::is_cold_action_condition< Cond >::value)
+        {
+            if (BOOST_LIKELY(m_data.m_active) && BOOST_UNLIKELY(m_data.get_cond()()))
+                detail::invoke_cold_action(m_data.get_func());
+        }
+        else
+        {
+            if (BOOST_LIKELY(m_data.m_active && m_data.get_cond()()))
+                m_data.get_func()();
+        }
     }
 
     /*!
@@ -481,6 +492,14 @@ public:
     }
 };
 
+//! \cond
+template< typename Func, typename Cond >
+struct is_trivially_relocatable< scope_exit< Func, Cond > > :
+    public detail::conjunction< is_trivially_relocatable< Func >, is_trivially_relocatable< Cond > >::type
+{
+};
+//! \endcond
+
 #if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
 template< typename Func >
 explicit scope_exit(Func) -> scope_exit< Func >;
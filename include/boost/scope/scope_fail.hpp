@@ -69,7 +69,8 @@ using is_not_like_scope_fail = detail::is_not_like< T, scope_fail >;
  * \tparam Cond Scope guard failure condition function object type.
  */
 template< typename Func, typename Cond = exception_checker >
-class scope_fail :
+class BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(detail::conjunction< is_trivially_relocatable< Func >, is_trivially_relocatable< Cond > >::value)
+scope_fail :
     public scope_exit< Func, Cond >
 {
 //! \cond
@@ -183,6 +184,14 @@ public:
     scope_fail& operator= (scope_fail const&) = delete;
 };
 
+//! \cond
+template< typename Func, typename Cond >
+struct is_trivially_relocatable< scope_fail< Func, Cond > > :
+    public detail::conjunction< is_trivially_relocatable< Func >, is_trivially_relocatable< Cond > >::type
+{
+};
+//! \endcond
+
 #if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
 template< typename Func >
 explicit scope_fail(Func) -> scope_fail< Func >;
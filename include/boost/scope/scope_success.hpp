@@ -53,7 +53,7 @@ public:
     using result_type = bool;
 
 private:
-    Func m_func;
+    BOOST_SCOPE_DETAIL_NO_UNIQUE_ADDRESS Func m_func;
 
 public:
     template<
@@ -113,7 +113,8 @@ public:
  * \tparam Cond Scope guard failure condition function object type.
  */
 template< typename Func, typename Cond = exception_checker >
-class scope_success :
+class BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(detail::conjunction< is_trivially_relocatable< Func >, is_trivially_relocatable< Cond > >::value)
+scope_success :
     public scope_exit< Func, detail::logical_not< Cond > >
 {
 //! \cond
@@ -227,6 +228,14 @@ public:
     scope_success& operator= (scope_success const&) = delete;
 };
 
+//! \cond
+template< typename Func, typename Cond >
+struct is_trivially_relocatable< scope_success< Func, Cond > > :
+    public detail::conjunction< is_trivially_relocatable< Func >, is_trivially_relocatable< Cond > >::type
+{
+};
+//! \endcond
+
 #if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
 template< typename Func >
 explicit scope_success(Func) -> scope_success< Func >;
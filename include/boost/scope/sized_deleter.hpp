@@ -0,0 +1,321 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/sized_deleter.hpp
+ *
+ * This header contains definition of \c sized_deleter and \c sized_free_deleter deleters,
+ * which pass the allocation size and alignment to the deallocation function.
+ */
+
+#ifndef BOOST_SCOPE_SIZED_DELETER_HPP_INCLUDED_
+#define BOOST_SCOPE_SIZED_DELETER_HPP_INCLUDED_
+
+#include <new>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <boost/assert.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+//! \cond
+namespace detail {
+
+#if defined(__STDCPP_DEFAULT_NEW_ALIGNMENT__)
+BOOST_CONSTEXPR_OR_CONST std::size_t default_new_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else
+BOOST_CONSTEXPR_OR_CONST std::size_t default_new_alignment = alignof(std::max_align_t);
+#endif
+
+BOOST_CONSTEXPR_OR_CONST std::size_t default_malloc_alignment = alignof(std::max_align_t);
+
+//! Returns binary logarithm of \a x, which must be a power of 2
+BOOST_CONSTEXPR inline unsigned int log2_pow2(std::size_t x) noexcept
+{
+    return x > 1u ? 1u + log2_pow2(x >> 1u) : 0u;
+}
+
+/*!
+ * \brief Storage of the allocation size and alignment.
+ *
+ * On 64-bit targets, binary logarithm of the alignment is packed in the most significant bits of the size,
+ * so that a buffer pointer with its deleter takes two words. The size must be less than 2<sup>56</sup>.
+ */
+template< bool Pack = (sizeof(std::size_t) * CHAR_BIT >= 64u) >
+class sized_deleter_storage
+{
+private:
+    static BOOST_CONSTEXPR_OR_CONST unsigned int alignment_shift = sizeof(std::size_t) * CHAR_BIT - 8u;
+    static BOOST_CONSTEXPR_OR_CONST std::size_t size_mask = (static_cast< std::size_t >(1u) << alignment_shift) - 1u;
+
+    std::size_t m_value;
+
+public:
+    constexpr sized_deleter_storage(std::size_t size, std::size_t alignment) noexcept :
+        m_value(check_size(size) | (static_cast< std::size_t >(log2_pow2(alignment)) << alignment_shift))
+    {
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return m_value & size_mask;
+    }
+
+    constexpr std::size_t alignment() const noexcept
+    {
+        return static_cast< std::size_t >(1u) << (m_value >> alignment_shift);
+    }
+
+private:
+    //! Verifies that the size fits in the packed representation
+    static constexpr std::size_t check_size(std::size_t size) noexcept
+    {
+        return BOOST_ASSERT_MSG(size <= size_mask, "Boost.Scope: sized_deleter allocation size is too large"), size & size_mask;
+    }
+};
+
+template< >
+class sized_deleter_storage< false >
+{
+private:
+    std::size_t m_size;
+    std::size_t m_alignment;
+
+public:
+    constexpr sized_deleter_storage(std::size_t size, std::size_t alignment) noexcept :
+        m_size(size),
+        m_alignment(alignment)
+    {
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    constexpr std::size_t alignment() const noexcept
+    {
+        return m_alignment;
+    }
+};
+
+//! Deallocates memory allocated with \c operator \c new
+inline void sized_operator_delete(void* p, std::size_t size, std::size_t alignment) noexcept
+{
+#if defined(__cpp_aligned_new) && __cpp_aligned_new >= 201606l
+    if (alignment > default_new_alignment)
+    {
+#if defined(__cpp_sized_deallocation) && __cpp_sized_deallocation >= 201309l
+        ::operator delete(p, size, static_cast< std::align_val_t >(alignment));
+#else
+        ::operator delete(p, static_cast< std::align_val_t >(alignment));
+#endif
+        return;
+    }
+#else
+    static_cast< void >(alignment);
+#endif
+
+#if defined(__cpp_sized_deallocation) && __cpp_sized_deallocation >= 201309l
+    ::operator delete(p, size);
+#else
+    static_cast< void >(size);
+    ::operator delete(p);
+#endif
+}
+
+//! Deallocates memory allocated with \c std::malloc or one of the aligned allocation functions
+inline void sized_free(void* p, std::size_t size, std::size_t alignment) noexcept
+{
+#if defined(BOOST_SCOPE_USE_SDALLOCX)
+    // MALLOCX_LG_ALIGN(la) is defined as la
+    ::sdallocx(p, size, alignment > default_malloc_alignment ? static_cast< int >(log2_pow2(alignment)) : 0);
+#elif defined(BOOST_SCOPE_USE_FREE_SIZED)
+    if (alignment > default_malloc_alignment)
+        ::free_aligned_sized(p, alignment, size);
+    else
+        ::free_sized(p, size);
+#else
+    static_cast< void >(size);
+    static_cast< void >(alignment);
+    std::free(p);
+#endif
+}
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Sized deleter for memory allocated with \c operator \c new.
+ *
+ * The deleter stores the size and alignment of the allocated memory and passes them to the sized and
+ * aligned forms of \c operator \c delete, where supported by the compiler. This allows memory allocators
+ * to avoid looking up the size class of the deallocated memory. The memory must have been allocated with
+ * `operator new(size)` or, if the alignment exceeds \c __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+ * `operator new(size, std::align_val_t(alignment))`.
+ *
+ * On 64-bit targets, the alignment is packed with the size, so the deleter occupies one word and the allocation
+ * size must be less than 2<sup>56</sup> bytes. Larger sizes fail an assertion.
+ */
+class sized_deleter
+{
+//! \cond
+private:
+    detail::sized_deleter_storage< > m_storage;
+
+//! \endcond
+public:
+    //! Deleter result type
+    using result_type = void;
+
+public:
+    /*!
+     * \brief Constructs a deleter for a zero-sized allocation with default alignment.
+     *
+     * **Throws:** Nothing.
+     */
+    constexpr sized_deleter() noexcept :
+        m_storage(0u, detail::default_new_alignment)
+    {
+    }
+
+    /*!
+     * \brief Constructs a deleter for an allocation of the given size and alignment.
+     *
+     * **Requires:** \a alignment is a power of 2.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param size Allocation size, in bytes.
+     * \param alignment Allocation alignment, in bytes.
+     */
+    constexpr explicit sized_deleter(std::size_t size, std::size_t alignment = detail::default_new_alignment) noexcept :
+        m_storage(size, alignment)
+    {
+    }
+
+    //! Returns the allocation size
+    constexpr std::size_t size() const noexcept
+    {
+        return m_storage.size();
+    }
+
+    //! Returns the allocation alignment
+    constexpr std::size_t alignment() const noexcept
+    {
+        return m_storage.alignment();
+    }
+
+    /*!
+     * \brief Deallocates memory.
+     *
+     * **Effects:** Calls `operator delete(p, size(), std::align_val_t(alignment()))`, if the alignment exceeds
+     *              \c __STDCPP_DEFAULT_NEW_ALIGNMENT__, or `operator delete(p, size())` otherwise. If sized or aligned
+     *              deallocation is not supported by the compiler, the corresponding argument is not passed.
+     *
+     * **Throws:** Nothing.
+     */
+    result_type operator() (void* p) const noexcept
+    {
+        detail::sized_operator_delete(p, m_storage.size(), m_storage.alignment());
+    }
+};
+
+/*!
+ * \brief Sized deleter for memory allocated with \c std::malloc.
+ *
+ * The deleter stores the size and alignment of the allocated memory and passes them to the sized deallocation
+ * function, if one is enabled by configuration macros:
+ *
+ * \li If \c BOOST_SCOPE_USE_SDALLOCX is defined, the deleter calls \c sdallocx, which is provided by jemalloc and tcmalloc.
+ *     The memory must have been allocated by the same allocator.
+ * \li Otherwise, if \c BOOST_SCOPE_USE_FREE_SIZED is defined, the deleter calls C23 \c free_sized or, for over-aligned
+ *     allocations, \c free_aligned_sized.
+ * \li Otherwise, the deleter calls \c std::free.
+ *
+ * When either macro is defined, the corresponding functions must be declared before including this header, e.g. by
+ * including the allocator header. The macros must be defined consistently in all translation units.
+ *
+ * The memory must have been allocated with \c std::malloc or, if the alignment exceeds `alignof(std::max_align_t)`,
+ * with \c std::aligned_alloc.
+ */
+class sized_free_deleter
+{
+//! \cond
+private:
+    detail::sized_deleter_storage< > m_storage;
+
+//! \endcond
+public:
+    //! Deleter result type
+    using result_type = void;
+
+public:
+    /*!
+     * \brief Constructs a deleter for a zero-sized allocation with default alignment.
+     *
+     * **Throws:** Nothing.
+     */
+    constexpr sized_free_deleter() noexcept :
+        m_storage(0u, detail::default_malloc_alignment)
+    {
+    }
+
+    /*!
+     * \brief Constructs a deleter for an allocation of the given size and alignment.
+     *
+     * **Requires:** \a alignment is a power of 2.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param size Allocation size, in bytes.
+     * \param alignment Allocation alignment, in bytes.
+     */
+    constexpr explicit sized_free_deleter(std::size_t size, std::size_t alignment = detail::default_malloc_alignment) noexcept :
+        m_storage(size, alignment)
+    {
+    }
+
+    //! Returns the allocation size
+    constexpr std::size_t size() const noexcept
+    {
+        return m_storage.size();
+    }
+
+    //! Returns the allocation alignment
+    constexpr std::size_t alignment() const noexcept
+    {
+        return m_storage.alignment();
+    }
+
+    /*!
+     * \brief Deallocates memory.
+     *
+     * **Effects:** Calls \c sdallocx, \c free_sized, \c free_aligned_sized or \c std::free, depending on configuration.
+     *
+     * **Throws:** Nothing.
+     */
+    result_type operator() (void* p) const noexcept
+    {
+        detail::sized_free(p, m_storage.size(), m_storage.alignment());
+    }
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_SIZED_DELETER_HPP_INCLUDED_
@@ -0,0 +1,350 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/thread_scope_exit.hpp
+ *
+ * This header contains definition of \c thread_scope_exit, which registers
+ * actions to be executed on thread exit.
+ */
+
+#ifndef BOOST_SCOPE_THREAD_SCOPE_EXIT_HPP_INCLUDED_
+#define BOOST_SCOPE_THREAD_SCOPE_EXIT_HPP_INCLUDED_
+
+#include <new>
+#include <cstddef>
+#include <type_traits>
+#include <boost/assert.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/type_traits/is_invocable.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if !defined(BOOST_SCOPE_THREAD_EXIT_MAX_ACTIONS)
+/*!
+ * \brief Maximum number of actions that can be registered with \c thread_scope_exit in a thread at the same time.
+ */
+#define BOOST_SCOPE_THREAD_EXIT_MAX_ACTIONS 32
+#endif
+
+#if !defined(BOOST_SCOPE_THREAD_EXIT_ACTION_SIZE)
+/*!
+ * \brief Maximum size of a function object, in bytes, that can be registered with \c thread_scope_exit.
+ */
+#define BOOST_SCOPE_THREAD_EXIT_ACTION_SIZE (4 * sizeof(void*))
+#endif
+
+namespace boost {
+namespace scope {
+
+//! \cond
+namespace detail {
+
+//! Storage for an action registered to be executed on thread exit
+struct thread_exit_slot
+{
+    alignas(std::max_align_t) unsigned char storage[BOOST_SCOPE_THREAD_EXIT_ACTION_SIZE];
+    void (*invoke)(void* func);
+    void (*destroy)(void* func) noexcept;
+    bool active;
+    bool used;
+};
+
+template< typename Func >
+struct thread_exit_action_ops
+{
+    static void invoke(void* func)
+    {
+        (*static_cast< Func* >(func))();
+    }
+
+    static void destroy(void* func) noexcept
+    {
+        static_cast< Func* >(func)->~Func();
+    }
+};
+
+//! Per-thread list of actions to be executed on thread exit
+class thread_exit_registry
+{
+public:
+    static BOOST_CONSTEXPR_OR_CONST std::size_t capacity = BOOST_SCOPE_THREAD_EXIT_MAX_ACTIONS;
+
+private:
+    thread_exit_slot m_slots[capacity];
+    std::size_t m_count;
+
+public:
+    thread_exit_registry() noexcept :
+        m_count(0u)
+    {
+    }
+
+    //! Executes the registered actions in the reverse order of registration
+    ~thread_exit_registry()
+    {
+        // Note: Actions may register more actions, which will be executed next. The slot of the running action
+        //       is kept occupied until the action is destroyed, so that new actions are placed in the slots above it.
+        while (m_count > 0u)
+        {
+            thread_exit_slot& slot = m_slots[m_count - 1u];
+            if (slot.used)
+            {
+                if (slot.active)
+                    slot.invoke(slot.storage);
+                slot.used = false;
+                slot.destroy(slot.storage);
+            }
+
+            reclaim();
+        }
+    }
+
+    thread_exit_registry(thread_exit_registry const&) = delete;
+    thread_exit_registry& operator= (thread_exit_registry const&) = delete;
+
+    //! Returns a slot for a new action or \c nullptr if there are no free slots
+    thread_exit_slot* allocate() noexcept
+    {
+        if (BOOST_UNLIKELY(m_count >= capacity))
+            return nullptr;
+
+        return &m_slots[m_count];
+    }
+
+    //! Marks the slot returned by \c allocate as used
+    void commit(thread_exit_slot* slot, bool active) noexcept
+    {
+        BOOST_ASSERT(slot == &m_slots[m_count]);
+        slot->active = active;
+        slot->used = true;
+        ++m_count;
+    }
+
+    //! Destroys the action and frees the slot
+    void free(thread_exit_slot* slot) noexcept
+    {
+        slot->used = false;
+        slot->destroy(slot->storage);
+        reclaim();
+    }
+
+private:
+    //! Reclaims unused slots at the top of the list
+    void reclaim() noexcept
+    {
+        while (m_count > 0u && !m_slots[m_count - 1u].used)
+            --m_count;
+    }
+};
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+//! Returns the registry of actions of the current thread
+inline thread_exit_registry& get_thread_exit_registry() noexcept
+{
+    static thread_local thread_exit_registry registry;
+    return registry;
+}
+
+#endif // !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Registers an action to be executed when the current thread exits.
+ *
+ * On construction, the function object is stored in a per-thread list of actions, which are executed
+ * in the reverse order of registration when the thread exits (more precisely, when the thread-local
+ * objects of the thread are destroyed). The action storage is preallocated in the thread-local storage,
+ * so registering an action does not allocate memory. The maximum number of actions registered in a thread
+ * and the maximum size of the function object are limited by \c BOOST_SCOPE_THREAD_EXIT_MAX_ACTIONS and
+ * \c BOOST_SCOPE_THREAD_EXIT_ACTION_SIZE configuration macros.
+ *
+ * The \c thread_scope_exit object is a handle to the registered action. Unlike \c scope_exit, destroying
+ * the handle does not execute or unregister the action. The handle can be used to activate or deactivate
+ * the action and to unregister it. The handle must only be used in the thread that registered the action
+ * and before the thread exits.
+ *
+ * If the action throws an exception when executed on thread exit, \c std::terminate is called.
+ */
+class thread_scope_exit
+{
+//! \cond
+private:
+    detail::thread_exit_slot* m_slot;
+
+//! \endcond
+public:
+    /*!
+     * \brief Constructs an empty handle, which does not refer to an action.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post `this->registered() == false`
+     */
+    constexpr thread_scope_exit() noexcept :
+        m_slot(nullptr)
+    {
+    }
+
+    /*!
+     * \brief Registers an action to be executed on thread exit.
+     *
+     * **Requires:** \c F is callable with no arguments, its decayed type fits in \c BOOST_SCOPE_THREAD_EXIT_ACTION_SIZE
+     *               bytes and does not require alignment stricter than that of \c std::max_align_t.
+     *
+     * **Effects:** Constructs the function object from `std::forward< F >(func)` in the per-thread storage. If the
+     *              maximum number of actions is already registered in the current thread, fails an assertion
+     *              (\c BOOST_ASSERT) and, if assertions are disabled, does not register the action and constructs
+     *              an empty handle. Callers that may exceed the limit must check `registered()`.
+     *
+     * **Throws:** Nothing, unless construction of the function object throws.
+     *
+     * \param func The callable action function object to invoke on thread exit.
+     * \param active Indicates whether the action should be active upon registration.
+     *
+     * \post `this->active() == active` if the action was registered.
+     */
+    template<
+        typename F
+        //! \cond
+        , typename Func = typename std::decay< F >::type
+        , typename = typename std::enable_if< detail::is_invocable< Func& >::value >::type
+        //! \endcond
+    >
+    explicit thread_scope_exit(F&& func, bool active = true)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_constructible< Func, F >::value)) :
+        m_slot(nullptr)
+    {
+        static_assert(sizeof(Func) <= BOOST_SCOPE_THREAD_EXIT_ACTION_SIZE,
+            "Boost.Scope: thread_scope_exit action function object is too large, increase BOOST_SCOPE_THREAD_EXIT_ACTION_SIZE");
+        static_assert(alignof(Func) <= alignof(std::max_align_t),
+            "Boost.Scope: thread_scope_exit action function object is overaligned");
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+        detail::thread_exit_registry& registry = detail::get_thread_exit_registry();
+        detail::thread_exit_slot* slot = registry.allocate();
+        BOOST_ASSERT_MSG(slot != nullptr, "Boost.Scope: too many thread_scope_exit actions registered, increase BOOST_SCOPE_THREAD_EXIT_MAX_ACTIONS");
+        if (BOOST_LIKELY(slot != nullptr))
+        {
+            new (slot->storage) Func(static_cast< F&& >(func));
+            slot->invoke = &detail::thread_exit_action_ops< Func >::invoke;
+            slot->destroy = &detail::thread_exit_action_ops< Func >::destroy;
+            registry.commit(slot, active);
+            m_slot = slot;
+        }
+#else
+        static_cast< void >(func);
+        static_cast< void >(active);
+#endif
+    }
+
+    /*!
+     * \brief Move-constructs a handle.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post \a that is empty.
+     */
+    thread_scope_exit(thread_scope_exit&& that) noexcept :
+        m_slot(that.m_slot)
+    {
+        that.m_slot = nullptr;
+    }
+
+    /*!
+     * \brief Move-assigns a handle.
+     *
+     * **Effects:** Makes `*this` refer to the action \a that referred to. Does not affect
+     *              the action `*this` referred to before the assignment.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post \a that is empty.
+     */
+    thread_scope_exit& operator= (thread_scope_exit&& that) noexcept
+    {
+        m_slot = that.m_slot;
+        if (&that != this)
+            that.m_slot = nullptr;
+        return *this;
+    }
+
+    thread_scope_exit(thread_scope_exit const&) = delete;
+    thread_scope_exit& operator= (thread_scope_exit const&) = delete;
+
+    //! Returns \c true if the handle refers to a registered action
+    bool registered() const noexcept
+    {
+        return m_slot != nullptr;
+    }
+
+    //! Returns \c true if the handle refers to a registered action
+    explicit operator bool () const noexcept
+    {
+        return registered();
+    }
+
+    /*!
+     * \brief Returns \c true if the action is registered and active, otherwise \c false.
+     *
+     * **Throws:** Nothing.
+     */
+    bool active() const noexcept
+    {
+        return m_slot != nullptr && m_slot->active;
+    }
+
+    /*!
+     * \brief Activates or deactivates the action.
+     *
+     * **Requires:** `this->registered() == true`.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param active The active status to set.
+     *
+     * \post `this->active() == active`
+     */
+    void set_active(bool active) noexcept
+    {
+        BOOST_ASSERT(m_slot != nullptr);
+        m_slot->active = active;
+    }
+
+    /*!
+     * \brief Unregisters the action without executing it.
+     *
+     * **Effects:** If the handle refers to a registered action, destroys the function object and frees its storage.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post `this->registered() == false`
+     */
+    void release() noexcept
+    {
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+        if (m_slot)
+        {
+            detail::get_thread_exit_registry().free(m_slot);
+            m_slot = nullptr;
+        }
+#endif
+    }
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_THREAD_SCOPE_EXIT_HPP_INCLUDED_
@@ -0,0 +1,342 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/timed_deleter.hpp
+ *
+ * This header contains definition of \c timed_deleter deleter adaptor
+ * for \c unique_resource.
+ */
+
+#ifndef BOOST_SCOPE_TIMED_DELETER_HPP_INCLUDED_
+#define BOOST_SCOPE_TIMED_DELETER_HPP_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <type_traits>
+#include <boost/scope/latency_histogram.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/compact_storage.hpp>
+#include <boost/scope/detail/is_nonnull_default_constructible.hpp>
+#include <boost/scope/detail/type_traits/is_nothrow_invocable.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+namespace detail {
+
+//! Latency histogram that is updated by a single thread and can be read concurrently by other threads
+class latency_recorder
+{
+    friend class latency_registry;
+
+private:
+    latency_recorder* m_prev;
+    latency_recorder* m_next;
+    std::atomic< std::uint64_t > m_counts[latency_histogram::bucket_count];
+    std::atomic< std::uint64_t > m_sum;
+
+public:
+    latency_recorder() noexcept :
+        m_prev(this),
+        m_next(this),
+        m_sum(0u)
+    {
+        for (std::size_t i = 0u; i < latency_histogram::bucket_count; ++i)
+            m_counts[i].store(0u, std::memory_order_relaxed);
+    }
+
+    latency_recorder(latency_recorder const&) = delete;
+    latency_recorder& operator= (latency_recorder const&) = delete;
+
+    //! Records the value. Must only be called by the owning thread.
+    void record(std::uint64_t value) noexcept
+    {
+        // Since there is only one writer, there's no need for atomic read-modify-write operations
+        std::atomic< std::uint64_t >& count = m_counts[latency_histogram::bucket_index(value)];
+        count.store(count.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+        m_sum.store(m_sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    //! Adds the recorded values to the histogram
+    void load(latency_histogram& hist) const noexcept
+    {
+        std::uint64_t total_count = 0u;
+        for (std::size_t i = 0u; i < latency_histogram::bucket_count; ++i)
+        {
+            const std::uint64_t count = m_counts[i].load(std::memory_order_relaxed);
+            hist.m_counts[i] += count;
+            total_count += count;
+        }
+        hist.m_total_count += total_count;
+        hist.m_sum += m_sum.load(std::memory_order_relaxed);
+    }
+
+    //! Resets the recorded values
+    void clear() noexcept
+    {
+        for (std::size_t i = 0u; i < latency_histogram::bucket_count; ++i)
+            m_counts[i].store(0u, std::memory_order_relaxed);
+        m_sum.store(0u, std::memory_order_relaxed);
+    }
+};
+
+//! Registry of per-thread latency recorders
+class latency_registry
+{
+private:
+    std::mutex m_mutex;
+    //! List of per-thread recorders
+    latency_recorder m_recorders;
+    //! Values recorded by threads that have terminated
+    latency_histogram m_retired;
+
+public:
+    void add(latency_recorder& rec) noexcept
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        rec.m_prev = m_recorders.m_prev;
+        rec.m_next = &m_recorders;
+        m_recorders.m_prev->m_next = &rec;
+        m_recorders.m_prev = &rec;
+    }
+
+    void remove(latency_recorder& rec) noexcept
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        rec.load(m_retired);
+        rec.m_prev->m_next = rec.m_next;
+        rec.m_next->m_prev = rec.m_prev;
+        rec.m_prev = rec.m_next = &rec;
+    }
+
+    void record(std::uint64_t value) noexcept
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_retired.record(value);
+    }
+
+    latency_histogram snapshot() noexcept
+    {
+        latency_histogram hist;
+        std::lock_guard< std::mutex > lock(m_mutex);
+        hist.merge(m_retired);
+        for (latency_recorder* rec = m_recorders.m_next; rec != &m_recorders; rec = rec->m_next)
+            rec->load(hist);
+        return hist;
+    }
+
+    void clear() noexcept
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_retired.clear();
+        for (latency_recorder* rec = m_recorders.m_next; rec != &m_recorders; rec = rec->m_next)
+            rec->clear();
+    }
+};
+
+//! Returns the registry of latency recorders for the given key type
+template< typename Key >
+inline latency_registry& get_latency_registry() noexcept
+{
+    static latency_registry registry;
+    return registry;
+}
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+//! Per-thread latency recorder that registers itself in the registry
+template< typename Key >
+class thread_latency_recorder :
+    public latency_recorder
+{
+public:
+    thread_latency_recorder() noexcept
+    {
+        detail::get_latency_registry< Key >().add(*this);
+    }
+
+    ~thread_latency_recorder()
+    {
+        detail::get_latency_registry< Key >().remove(*this);
+    }
+};
+
+#endif // !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+//! Records a latency value in the per-thread recorder for the given key type
+template< typename Key >
+inline void record_latency(std::uint64_t value) noexcept
+{
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+    static thread_local thread_latency_recorder< Key > recorder;
+    recorder.record(value);
+#else
+    detail::get_latency_registry< Key >().record(value);
+#endif
+}
+
+} // namespace detail
+
+/*!
+ * \brief Deleter adaptor that measures execution time of the adapted deleter.
+ *
+ * The adaptor invokes the adapted deleter and records the time it took to execute
+ * into a log-linear histogram. Recording is lock-free, as every thread records into
+ * its own histogram. Histograms of all threads can be merged by calling \c snapshot.
+ *
+ * The histograms are shared between all \c timed_deleter objects with the same
+ * template parameters.
+ *
+ * \tparam Deleter The adapted deleter type.
+ * \tparam Clock Clock type. Must provide a static \c now member function returning
+ *               a time point. Subtracting time points must produce a duration with
+ *               a \c count member function returning an integer number of ticks.
+ *               The ticks are recorded in the histogram.
+ * \tparam Tag Tag type that allows to maintain separate histograms for the same deleter type.
+ */
+template< typename Deleter, typename Clock = std::chrono::steady_clock, typename Tag = void >
+class timed_deleter :
+    private detail::compact_storage< Deleter >
+{
+public:
+    //! Adapted deleter type
+    using deleter_type = Deleter;
+    //! Clock type
+    using clock_type = Clock;
+
+//! \cond
+private:
+    using deleter_base = detail::compact_storage< Deleter >;
+    using registry_key = timed_deleter< Deleter, Clock, Tag >;
+
+//! \endcond
+public:
+    /*!
+     * \brief Default-constructs the adapted deleter.
+     *
+     * **Throws:** Nothing, unless default-constructing the deleter throws.
+     */
+    //! \cond
+    template<
+        bool Requires = detail::is_nonnull_default_constructible< Deleter >::value,
+        typename = typename std::enable_if< Requires >::type
+    >
+    //! \endcond
+    timed_deleter() noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_default_constructible< Deleter >::value)) :
+        deleter_base()
+    {
+    }
+
+    /*!
+     * \brief Constructs the adapted deleter from the argument.
+     *
+     * **Throws:** Nothing, unless constructing the deleter throws.
+     */
+    template<
+        typename D
+        //! \cond
+        , typename = typename std::enable_if< detail::conjunction<
+            std::is_constructible< Deleter, D >,
+            detail::negation< std::is_same< typename std::decay< D >::type, timed_deleter > >
+        >::value >::type
+        //! \endcond
+    >
+    explicit timed_deleter(D&& del) noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_constructible< Deleter, D >::value)) :
+        deleter_base(static_cast< D&& >(del))
+    {
+    }
+
+    //! Returns a reference to the adapted deleter
+    deleter_type& get_deleter() noexcept
+    {
+        return deleter_base::get();
+    }
+
+    //! Returns a reference to the adapted deleter
+    deleter_type const& get_deleter() const noexcept
+    {
+        return deleter_base::get();
+    }
+
+    /*!
+     * \brief Invokes the adapted deleter and records its execution time.
+     *
+     * **Throws:** Nothing, unless the adapted deleter throws. The execution time is not
+     *             recorded if the deleter throws.
+     */
+    template< typename Resource >
+    void operator() (Resource&& res)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_invocable< Deleter&, Resource&& >::value))
+    {
+        timed_invoke(deleter_base::get(), static_cast< Resource&& >(res));
+    }
+
+    /*!
+     * \brief Invokes the adapted deleter and records its execution time.
+     *
+     * **Throws:** Nothing, unless the adapted deleter throws. The execution time is not
+     *             recorded if the deleter throws.
+     */
+    template< typename Resource >
+    void operator() (Resource&& res) const
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_invocable< Deleter const&, Resource&& >::value))
+    {
+        timed_invoke(deleter_base::get(), static_cast< Resource&& >(res));
+    }
+
+    /*!
+     * \brief Returns a histogram of the deleter execution times, merged from all threads.
+     *
+     * **Throws:** Nothing.
+     */
+    static latency_histogram snapshot() noexcept
+    {
+        return detail::get_latency_registry< registry_key >().snapshot();
+    }
+
+    /*!
+     * \brief Clears the histograms of the deleter execution times of all threads.
+     *
+     * \note If other threads are invoking the deleter concurrently, some of their recorded
+     *       execution times may be lost or not cleared.
+     *
+     * **Throws:** Nothing.
+     */
+    static void clear() noexcept
+    {
+        detail::get_latency_registry< registry_key >().clear();
+    }
+
+//! \cond
+private:
+    //! Invokes the deleter and records its execution time
+    template< typename D, typename Resource >
+    static void timed_invoke(D& del, Resource&& res) noexcept(detail::is_nothrow_invocable< D&, Resource&& >::value)
+    {
+        const typename Clock::time_point start = Clock::now();
+        del(static_cast< Resource&& >(res));
+        const typename Clock::time_point end = Clock::now();
+        detail::record_latency< registry_key >(static_cast< std::uint64_t >((end - start).count()));
+    }
+
+//! \endcond
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_TIMED_DELETER_HPP_INCLUDED_
@@ -0,0 +1,496 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/trace_scope.hpp
+ *
+ * This header contains definition of \c trace_scope scope guard and the
+ * associated tracing components.
+ *
+ * Tracing can be disabled at compile time by defining \c BOOST_SCOPE_DISABLE_TRACING.
+ * In this case, \c trace_scope does not record anything and \c drain_trace_records
+ * does not report any records.
+ */
+
+#ifndef BOOST_SCOPE_TRACE_SCOPE_HPP_INCLUDED_
+#define BOOST_SCOPE_TRACE_SCOPE_HPP_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+#include <boost/scope/tsc_clock.hpp>
+#include <boost/scope/defer_macro.hpp>
+#include <boost/scope/detail/config.hpp>
+#if !defined(BOOST_SCOPE_DISABLE_TRACING)
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <boost/scope/defer.hpp>
+#endif
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if !defined(BOOST_SCOPE_TRACE_BUFFER_SIZE)
+/*!
+ * \brief Capacity of the per-thread trace buffer, in records.
+ *
+ * The value must be a power of two. When the buffer is full, new records are dropped
+ * until the buffer is drained.
+ */
+#define BOOST_SCOPE_TRACE_BUFFER_SIZE 4096
+#endif
+
+namespace boost {
+namespace scope {
+
+//! Trace event kind
+enum class trace_event : std::uint32_t
+{
+    //! Entering a traced scope
+    begin,
+    //! Leaving a traced scope
+    end
+};
+
+/*!
+ * \brief Trace record.
+ */
+struct trace_record
+{
+    //! Timestamp of the event, in \c tsc_clock ticks
+    tsc_clock::rep timestamp;
+    //! Name of the traced scope
+    const char* name;
+    //! Event kind
+    trace_event event;
+};
+
+#if !defined(BOOST_SCOPE_DISABLE_TRACING)
+
+namespace detail {
+
+static_assert((BOOST_SCOPE_TRACE_BUFFER_SIZE) > 0 && ((BOOST_SCOPE_TRACE_BUFFER_SIZE) & ((BOOST_SCOPE_TRACE_BUFFER_SIZE) - 1)) == 0,
+    "Boost.Scope: BOOST_SCOPE_TRACE_BUFFER_SIZE must be a power of two");
+
+//! Cache line size used to separate data modified by different threads
+BOOST_CONSTEXPR_OR_CONST std::size_t trace_cache_line_size = 64u;
+
+/*!
+ * \brief Single-producer single-consumer ring buffer of trace records.
+ *
+ * The producer is the thread that owns the buffer. Consumers are serialized by the registry mutex.
+ */
+class trace_buffer
+{
+    friend class trace_registry;
+
+public:
+    //! Buffer capacity
+    static BOOST_CONSTEXPR_OR_CONST std::size_t capacity = static_cast< std::size_t >(BOOST_SCOPE_TRACE_BUFFER_SIZE);
+
+private:
+    //! Index of the next record to be written, modified by the producer
+    std::atomic< std::size_t > m_head;
+    //! Number of records dropped because the buffer was full, modified by the producer
+    std::atomic< std::uint64_t > m_dropped;
+    unsigned char m_padding1[trace_cache_line_size - sizeof(std::atomic< std::size_t >) - sizeof(std::atomic< std::uint64_t >)];
+    //! Index of the next record to be read, modified by the consumer
+    std::atomic< std::size_t > m_tail;
+    unsigned char m_padding2[trace_cache_line_size - sizeof(std::atomic< std::size_t >)];
+
+    //! Number of dropped records that were already reported by the consumer
+    std::uint64_t m_dropped_reported;
+    //! Indicates that the owning thread has terminated
+    bool m_detached;
+    //! Id of the owning thread
+    std::thread::id m_thread_id;
+    trace_buffer* m_prev;
+    trace_buffer* m_next;
+
+    trace_record m_records[capacity];
+
+public:
+    trace_buffer() noexcept :
+        m_head(0u),
+        m_dropped(0u),
+        m_tail(0u),
+        m_dropped_reported(0u),
+        m_detached(false),
+        m_thread_id(std::this_thread::get_id()),
+        m_prev(this),
+        m_next(this)
+    {
+    }
+
+    trace_buffer(trace_buffer const&) = delete;
+    trace_buffer& operator= (trace_buffer const&) = delete;
+
+    //! Appends a record to the buffer. Must only be called by the owning thread. Wait-free.
+    void push(trace_event event, const char* name) noexcept
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (BOOST_UNLIKELY((head - m_tail.load(std::memory_order_acquire)) >= capacity))
+        {
+            // Only the producer modifies the counter, so no need for atomic read-modify-write operations
+            m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+            return;
+        }
+
+        trace_record& rec = m_records[head & (capacity - 1u)];
+        rec.timestamp = tsc_clock::now().time_since_epoch().count();
+        rec.name = name;
+        rec.event = event;
+        m_head.store(head + 1u, std::memory_order_release);
+    }
+
+    //! Passes the records accumulated in the buffer to the function and marks them consumed. Returns the number of newly dropped records.
+    template< typename Func >
+    std::uint64_t drain(Func& func)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        if (head != tail)
+        {
+            const std::size_t pos = tail & (capacity - 1u);
+            const std::size_t size = head - tail;
+            const std::size_t size1 = (capacity - pos) < size ? (capacity - pos) : size;
+            func(m_thread_id, static_cast< trace_record const* >(m_records + pos), size1);
+            // Mark the first segment consumed before passing the second one, in case func throws
+            m_tail.store(tail + size1, std::memory_order_release);
+            if (size1 < size)
+            {
+                func(m_thread_id, static_cast< trace_record const* >(m_records), size - size1);
+                m_tail.store(head, std::memory_order_release);
+            }
+        }
+
+        const std::uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        const std::uint64_t new_dropped = dropped - m_dropped_reported;
+        m_dropped_reported = dropped;
+        return new_dropped;
+    }
+
+    //! Returns \c true if the buffer contains no records
+    bool empty() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+    }
+};
+
+//! Registry of per-thread trace buffers
+class trace_registry
+{
+private:
+    std::mutex m_mutex;
+    //! List of trace buffers
+    trace_buffer* m_buffers;
+
+public:
+    trace_registry() noexcept :
+        m_buffers(nullptr)
+    {
+    }
+
+    /*!
+     * Deletes the buffers of the terminated threads. The buffers of the threads that are still running
+     * are left to their owning threads, which delete them on termination.
+     */
+    ~trace_registry()
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        trace_buffer* buf = m_buffers;
+        while (buf)
+        {
+            trace_buffer* next = buf->m_next != m_buffers ? buf->m_next : nullptr;
+            if (buf->m_detached)
+                delete buf;
+            buf = next;
+        }
+
+        m_buffers = nullptr;
+        destroyed().store(true, std::memory_order_release);
+    }
+
+    //! Returns a flag that indicates that the registry was destroyed
+    static std::atomic< bool >& destroyed() noexcept
+    {
+        // std::atomic< bool > is trivially destructible, so the flag remains usable during and after static destruction
+        static std::atomic< bool > flag(false);
+        return flag;
+    }
+
+    trace_registry(trace_registry const&) = delete;
+    trace_registry& operator= (trace_registry const&) = delete;
+
+    //! Allocates a new trace buffer for the current thread
+    trace_buffer* create_buffer() noexcept
+    {
+        trace_buffer* buf = new (std::nothrow) trace_buffer();
+        if (BOOST_LIKELY(buf != nullptr))
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            if (m_buffers)
+            {
+                buf->m_prev = m_buffers->m_prev;
+                buf->m_next = m_buffers;
+                m_buffers->m_prev->m_next = buf;
+                m_buffers->m_prev = buf;
+            }
+            else
+            {
+                m_buffers = buf;
+            }
+        }
+
+        return buf;
+    }
+
+    //! Marks the trace buffer as detached from its thread. The buffer is deleted once all its records are drained.
+    void detach_buffer(trace_buffer* buf) noexcept
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        if (buf->empty())
+            unlink_and_delete(buf);
+        else
+            buf->m_detached = true;
+    }
+
+    //! Drains all trace buffers
+    template< typename Func >
+    std::uint64_t drain(Func& func)
+    {
+        std::uint64_t dropped = 0u;
+        std::lock_guard< std::mutex > lock(m_mutex);
+        trace_buffer* buf = m_buffers;
+        while (buf)
+        {
+            trace_buffer* next = buf->m_next != m_buffers ? buf->m_next : nullptr;
+            dropped += buf->drain(func);
+            if (buf->m_detached)
+                unlink_and_delete(buf);
+            buf = next;
+        }
+
+        return dropped;
+    }
+
+private:
+    void unlink_and_delete(trace_buffer* buf) noexcept
+    {
+        if (buf->m_next != buf)
+        {
+            buf->m_prev->m_next = buf->m_next;
+            buf->m_next->m_prev = buf->m_prev;
+            if (m_buffers == buf)
+                m_buffers = buf->m_next;
+        }
+        else
+        {
+            m_buffers = nullptr;
+        }
+
+        delete buf;
+    }
+};
+
+//! Returns the trace buffer registry
+inline trace_registry& get_trace_registry() noexcept
+{
+    static trace_registry registry;
+    return registry;
+}
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+//! Per-thread trace buffer owner
+class thread_trace_buffer
+{
+private:
+    trace_buffer* m_buffer;
+
+public:
+    thread_trace_buffer() noexcept :
+        m_buffer(!trace_registry::destroyed().load(std::memory_order_acquire) ? detail::get_trace_registry().create_buffer() : nullptr)
+    {
+    }
+
+    ~thread_trace_buffer()
+    {
+        if (m_buffer)
+        {
+            // If the registry is already destroyed, the buffer is owned by this thread
+            if (!trace_registry::destroyed().load(std::memory_order_acquire))
+                detail::get_trace_registry().detach_buffer(m_buffer);
+            else
+                delete m_buffer;
+        }
+    }
+
+    thread_trace_buffer(thread_trace_buffer const&) = delete;
+    thread_trace_buffer& operator= (thread_trace_buffer const&) = delete;
+
+    trace_buffer* get() const noexcept
+    {
+        return m_buffer;
+    }
+};
+
+//! Writes a trace record into the current thread's buffer
+inline void trace(trace_event event, const char* name) noexcept
+{
+    static thread_local thread_trace_buffer buffer;
+    trace_buffer* buf = buffer.get();
+    if (BOOST_LIKELY(buf != nullptr))
+        buf->push(event, name);
+}
+
+#else // !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+inline void trace(trace_event, const char*) noexcept
+{
+}
+
+#endif // !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+
+//! Scope exit action that writes a trace end record
+class trace_end_action
+{
+private:
+    const char* m_name;
+
+public:
+    explicit trace_end_action(const char* name) noexcept :
+        m_name(name)
+    {
+    }
+
+    void operator() () const noexcept
+    {
+        detail::trace(trace_event::end, m_name);
+    }
+};
+
+} // namespace detail
+
+#endif // !defined(BOOST_SCOPE_DISABLE_TRACING)
+
+/*!
+ * \brief Scope guard that records entering and leaving a scope in a trace buffer.
+ *
+ * On construction, the scope guard writes a \c trace_event::begin record into
+ * the trace buffer of the current thread. On destruction, the scope guard writes
+ * a \c trace_event::end record into the same buffer. The records contain a timestamp
+ * obtained from \c tsc_clock and the pointer to the scope name.
+ *
+ * Writing records is wait-free, except for the first record written in a thread, which
+ * allocates and registers the trace buffer of that thread. If the buffer is full, the records
+ * are dropped. The accumulated records can be retrieved by calling \c drain_trace_records.
+ *
+ * The scope name is not copied, it must remain valid until the records are drained.
+ * Typically, the name is a string literal.
+ *
+ * If \c BOOST_SCOPE_DISABLE_TRACING is defined, the scope guard does nothing.
+ */
+class trace_scope
+#if !defined(BOOST_SCOPE_DISABLE_TRACING)
+    : public defer_guard< detail::trace_end_action >
+#endif
+{
+//! \cond
+private:
+#if !defined(BOOST_SCOPE_DISABLE_TRACING)
+    using base_type = defer_guard< detail::trace_end_action >;
+#endif
+
+//! \endcond
+public:
+    /*!
+     * \brief Writes a trace begin record.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param name Scope name.
+     */
+    explicit trace_scope(const char* name) noexcept
+#if !defined(BOOST_SCOPE_DISABLE_TRACING)
+        : base_type(detail::trace_end_action(name))
+    {
+        detail::trace(trace_event::begin, name);
+    }
+#else
+    {
+        static_cast< void >(name);
+    }
+#endif
+
+    trace_scope(trace_scope const&) = delete;
+    trace_scope& operator= (trace_scope const&) = delete;
+};
+
+/*!
+ * \brief Retrieves trace records accumulated in all threads.
+ *
+ * The function invokes \a func for each contiguous sequence of trace records accumulated in the trace
+ * buffer of every thread, including the threads that have terminated since the last call. The function
+ * object is called with the following arguments:
+ *
+ * \li `std::thread::id` - id of the thread that wrote the records,
+ * \li `trace_record const*` - pointer to the first record in the sequence,
+ * \li `std::size_t` - the number of records in the sequence.
+ *
+ * The records are passed directly from the trace buffers without copying. The pointers remain valid
+ * only during the call to \a func. After \a func returns, the records are removed from the buffer.
+ * Records of a given thread are passed in the order they were written.
+ *
+ * Calls to \c drain_trace_records are serialized. The function object must not call
+ * \c drain_trace_records and must not write trace records in a thread that did not write
+ * trace records before.
+ *
+ * **Throws:** Nothing, unless \a func throws. If \a func throws, the sequence of records passed to it
+ *             and the following records are not removed from the buffer. The sequences passed in the
+ *             previous calls to \a func are removed.
+ *
+ * \param func The function object that receives trace records.
+ * \returns The number of records that were dropped because trace buffers were full,
+ *          since the previous call to \c drain_trace_records.
+ */
+template< typename Func >
+inline std::uint64_t drain_trace_records(Func&& func)
+{
+#if !defined(BOOST_SCOPE_DISABLE_TRACING)
+    return detail::get_trace_registry().drain(func);
+#else
+    static_cast< void >(func);
+    return 0u;
+#endif
+}
+
+} // namespace scope
+} // namespace boost
+
+/*!
+ * \brief The macro creates a uniquely named \c trace_scope guard with the given name.
+ *
+ * Usage example:
+ *
+ * ```
+ * void process()
+ * {
+ *     BOOST_SCOPE_TRACE("process");
+ *     // ...
+ * }
+ * ```
+ */
+#define BOOST_SCOPE_TRACE(name) \
+    boost::scope::trace_scope BOOST_JOIN(_boost_trace_scope_, BOOST_SCOPE_DETAIL_UNIQUE_VAR_TAG)(name)
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_TRACE_SCOPE_HPP_INCLUDED_
@@ -0,0 +1,433 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/transaction_scope.hpp
+ *
+ * This header contains definition of \c transaction_scope, which maintains a log
+ * of undo actions and replays them on failure.
+ */
+
+#ifndef BOOST_SCOPE_TRANSACTION_SCOPE_HPP_INCLUDED_
+#define BOOST_SCOPE_TRANSACTION_SCOPE_HPP_INCLUDED_
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/scope/exception_checker.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/cold_action.hpp>
+#include <boost/scope/detail/compact_storage.hpp>
+#include <boost/scope/detail/move_or_copy_construct_ref.hpp>
+#include <boost/scope/detail/type_traits/is_invocable.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+//! \cond
+namespace detail {
+
+//! Header of an undo record in the transaction log. The undo action object follows the header.
+struct undo_record
+{
+    //! Previously added record
+    undo_record* prev;
+    //! Invokes the undo action and destroys it
+    void (*undo)(undo_record* rec) noexcept;
+    //! Destroys the undo action without invoking it
+    void (*destroy)(undo_record* rec) noexcept;
+};
+
+template< typename Func >
+struct undo_record_ops
+{
+    //! Offset of the undo action object from the beginning of the record
+    static BOOST_CONSTEXPR_OR_CONST std::size_t offset = (sizeof(undo_record) + alignof(Func) - 1u) & ~(alignof(Func) - 1u);
+    //! Size of the record
+    static BOOST_CONSTEXPR_OR_CONST std::size_t size = offset + sizeof(Func);
+    //! Alignment of the record
+    static BOOST_CONSTEXPR_OR_CONST std::size_t alignment = alignof(Func) > alignof(undo_record) ? alignof(Func) : alignof(undo_record);
+
+    static void* get(undo_record* rec) noexcept
+    {
+        return reinterpret_cast< unsigned char* >(rec) + offset;
+    }
+
+    static void undo(undo_record* rec) noexcept
+    {
+        Func& func = *static_cast< Func* >(get(rec));
+        func();
+        func.~Func();
+    }
+
+    static void destroy(undo_record* rec) noexcept
+    {
+        static_cast< Func* >(get(rec))->~Func();
+    }
+};
+
+//! Overflow storage chunk of the transaction log
+struct alignas(std::max_align_t) undo_log_chunk
+{
+    undo_log_chunk* next;
+};
+
+//! Transaction log of undo records
+class undo_log
+{
+public:
+    //! The minimum size of an overflow chunk
+    static BOOST_CONSTEXPR_OR_CONST std::size_t min_chunk_size = 1024u;
+
+private:
+    unsigned char* m_inline_begin;
+    unsigned char* m_inline_end;
+    unsigned char* m_pos;
+    unsigned char* m_end;
+    undo_log_chunk* m_chunks;
+    undo_record* m_last;
+    std::size_t m_size;
+    bool m_has_destructors;
+
+public:
+    undo_log(unsigned char* inline_begin, unsigned char* inline_end) noexcept :
+        m_inline_begin(inline_begin),
+        m_inline_end(inline_end),
+        m_pos(inline_begin),
+        m_end(inline_end),
+        m_chunks(nullptr),
+        m_last(nullptr),
+        m_size(0u),
+        m_has_destructors(false)
+    {
+    }
+
+    undo_log(undo_log const&) = delete;
+    undo_log& operator= (undo_log const&) = delete;
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /*!
+     * Allocates storage for a record. The storage is not committed to the log until the record is added
+     * with \c push, so the next call to \c allocate returns the same storage if the record is not added.
+     */
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        unsigned char* p = align(m_pos, alignment);
+        if (BOOST_UNLIKELY(p > m_end || static_cast< std::size_t >(m_end - p) < size))
+            p = allocate_chunk(size, alignment);
+
+        return p;
+    }
+
+    //! Adds a record of \a size bytes to the log. The record must have been allocated with the last call to \c allocate.
+    void push(undo_record* rec, std::size_t size, bool has_destructor) noexcept
+    {
+        m_pos = reinterpret_cast< unsigned char* >(rec) + size;
+        rec->prev = m_last;
+        m_last = rec;
+        ++m_size;
+        m_has_destructors |= has_destructor;
+    }
+
+    //! Invokes undo actions in the reverse order of addition and clears the log
+    BOOST_NOINLINE BOOST_SCOPE_DETAIL_COLD void rollback() noexcept
+    {
+        for (undo_record* rec = m_last; rec != nullptr; rec = rec->prev)
+            rec->undo(rec);
+
+        clear();
+    }
+
+    //! Destroys all undo actions without invoking them and clears the log
+    void discard() noexcept
+    {
+        if (m_has_destructors)
+        {
+            for (undo_record* rec = m_last; rec != nullptr; rec = rec->prev)
+                rec->destroy(rec);
+        }
+
+        clear();
+    }
+
+private:
+    static unsigned char* align(unsigned char* p, std::size_t alignment) noexcept
+    {
+        const std::size_t misalignment = static_cast< std::size_t >(reinterpret_cast< std::uintptr_t >(p)) & (alignment - 1u);
+        if (misalignment != 0u)
+            p += alignment - misalignment;
+        return p;
+    }
+
+    //! Allocates a new overflow chunk and returns a pointer to the aligned storage of \a size bytes in it
+    unsigned char* allocate_chunk(std::size_t size, std::size_t alignment)
+    {
+        std::size_t chunk_size = size + alignment;
+        if (chunk_size < min_chunk_size)
+            chunk_size = min_chunk_size;
+
+        undo_log_chunk* chunk = static_cast< undo_log_chunk* >(::operator new(sizeof(undo_log_chunk) + chunk_size));
+        chunk->next = m_chunks;
+        m_chunks = chunk;
+
+        unsigned char* begin = reinterpret_cast< unsigned char* >(chunk + 1);
+        m_pos = begin;
+        m_end = begin + chunk_size;
+        return align(begin, alignment);
+    }
+
+    void clear() noexcept
+    {
+        undo_log_chunk* chunk = m_chunks;
+        while (chunk)
+        {
+            undo_log_chunk* next = chunk->next;
+            ::operator delete(chunk);
+            chunk = next;
+        }
+
+        m_chunks = nullptr;
+        m_pos = m_inline_begin;
+        m_end = m_inline_end;
+        m_last = nullptr;
+        m_size = 0u;
+        m_has_destructors = false;
+    }
+};
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief A transaction scope that maintains a log of undo actions.
+ *
+ * The transaction scope replaces a sequence of \c scope_fail scope guards, one per step of a multi-step
+ * operation. After performing each step, the user adds an undo action for the step to the transaction
+ * log. On destruction, if the log is not empty and the condition function object returns \c true,
+ * the undo actions are invoked in the reverse order of addition. Otherwise, the undo actions are
+ * destroyed without being invoked. Calling \c commit discards the undo actions, and calling \c rollback
+ * invokes them immediately. In both cases the log becomes empty and new undo actions can be added.
+ *
+ * Compared to a sequence of scope guards, the transaction scope calls the condition function object
+ * at most once and does not maintain per-action active flags. The undo actions are stored in a contiguous
+ * inline buffer of \c InlineCapacity bytes. When the buffer is exhausted, additional storage is
+ * allocated dynamically in large chunks.
+ *
+ * Undo actions must be callable with no arguments. If an undo action throws an exception, \c std::terminate
+ * is called.
+ *
+ * The transaction scope is neither copyable nor movable.
+ *
+ * \tparam Cond Condition function object type. The default condition indicates whether an exception is being thrown.
+ * \tparam InlineCapacity Size of the inline buffer for undo actions, in bytes.
+ */
+template< typename Cond = exception_checker, std::size_t InlineCapacity = 256u >
+class transaction_scope :
+    private detail::compact_storage< Cond >
+{
+//! \cond
+private:
+    using cond_base = detail::compact_storage< Cond >;
+
+    detail::undo_log m_log;
+    alignas(std::max_align_t) unsigned char m_storage[InlineCapacity > 0u ? InlineCapacity : 1u];
+
+//! \endcond
+public:
+    /*!
+     * \brief Constructs an empty transaction scope with a default-constructed condition function object.
+     *
+     * **Throws:** Nothing, unless construction of the condition function object throws.
+     */
+    transaction_scope() noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_default_constructible< Cond >::value)) :
+        cond_base(),
+        m_log(m_storage, m_storage + InlineCapacity)
+    {
+    }
+
+    /*!
+     * \brief Constructs an empty transaction scope with the given condition function object.
+     *
+     * **Throws:** Nothing, unless construction of the condition function object throws.
+     *
+     * \param cond The condition function object, which indicates whether the undo actions should be invoked on destruction.
+     */
+    template<
+        typename C
+        //! \cond
+        , typename = typename std::enable_if< std::is_constructible< Cond, C >::value >::type
+        //! \endcond
+    >
+    explicit transaction_scope(C&& cond) noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_constructible< Cond, C >::value)) :
+        cond_base(static_cast< C&& >(cond)),
+        m_log(m_storage, m_storage + InlineCapacity)
+    {
+    }
+
+    transaction_scope(transaction_scope const&) = delete;
+    transaction_scope& operator= (transaction_scope const&) = delete;
+
+    /*!
+     * \brief Replays or discards the undo actions.
+     *
+     * **Effects:** If the log is not empty and the condition function object returns \c true, invokes
+     *              the undo actions in the reverse order of addition. Otherwise, destroys the undo actions
+     *              without invoking them.
+     *
+     * **Throws:** Nothing.
+     */
+    ~transaction_scope()
+    {
+        if (m_log.size() > 0u)
+        {
+            if (BOOST_UNLIKELY(!!cond_base::get()()))
+                m_log.rollback();
+            else
+                m_log.discard();
+        }
+    }
+
+    /*!
+     * \brief Adds an undo action to the log.
+     *
+     * **Requires:** \c std::decay_t< F > is callable with no arguments.
+     *
+     * **Effects:** If the undo action type is nothrow constructible from `F&&` then constructs it from
+     *              `std::forward< F >(undo)`, otherwise constructs from `undo`. If allocating storage or
+     *              constructing the undo action throws, invokes \a undo and rethrows the exception.
+     *
+     * **Throws:** Nothing, unless allocating storage or constructing the undo action throws.
+     *
+     * \param undo The undo action function object.
+     */
+    template<
+        typename F
+        //! \cond
+        , typename Func = typename std::decay< F >::type
+        , typename = typename std::enable_if< detail::is_invocable< Func& >::value >::type
+        //! \endcond
+    >
+    void push_undo(F&& undo)
+    {
+        using ops = detail::undo_record_ops< Func >;
+        BOOST_TRY
+        {
+            void* p = m_log.allocate(ops::size, ops::alignment);
+            new (ops::get(static_cast< detail::undo_record* >(p))) Func(static_cast< typename detail::move_or_copy_construct_ref< F, Func >::type >(undo));
+            add_record< Func >(p);
+        }
+        BOOST_CATCH(...)
+        {
+            undo();
+            BOOST_RETHROW;
+        }
+        BOOST_CATCH_END
+    }
+
+    /*!
+     * \brief Constructs an undo action of type \c Func in the log.
+     *
+     * **Requires:** \c Func is callable with no arguments and is constructible from \a args.
+     *
+     * **Effects:** Constructs an object of type \c Func from `std::forward< Args >(args)...` in the log. If allocating
+     *              storage or constructing the undo action throws, the log is unchanged.
+     *
+     * **Throws:** Nothing, unless allocating storage or constructing the undo action throws.
+     *
+     * \param args Arguments for the undo action constructor.
+     * \returns A reference to the constructed undo action.
+     */
+    template< typename Func, typename... Args >
+    Func& emplace_undo(Args&&... args)
+    {
+        static_assert(detail::is_invocable< Func& >::value, "Boost.Scope: transaction_scope undo action must be callable with no arguments");
+        using ops = detail::undo_record_ops< Func >;
+        void* p = m_log.allocate(ops::size, ops::alignment);
+        Func* func = new (ops::get(static_cast< detail::undo_record* >(p))) Func(static_cast< Args&& >(args)...);
+        add_record< Func >(p);
+        return *func;
+    }
+
+    /*!
+     * \brief Commits the transaction.
+     *
+     * **Effects:** Destroys the undo actions without invoking them.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post `this->empty() == true`
+     */
+    void commit() noexcept
+    {
+        m_log.discard();
+    }
+
+    /*!
+     * \brief Rolls back the transaction.
+     *
+     * **Effects:** Invokes the undo actions in the reverse order of addition and destroys them.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post `this->empty() == true`
+     */
+    void rollback() noexcept
+    {
+        m_log.rollback();
+    }
+
+    /*!
+     * \brief Returns the number of undo actions in the log.
+     *
+     * **Throws:** Nothing.
+     */
+    std::size_t size() const noexcept
+    {
+        return m_log.size();
+    }
+
+    /*!
+     * \brief Returns \c true if the log contains no undo actions, otherwise \c false.
+     *
+     * **Throws:** Nothing.
+     */
+    bool empty() const noexcept
+    {
+        return m_log.size() == 0u;
+    }
+
+//! \cond
+private:
+    template< typename Func >
+    void add_record(void* p) noexcept
+    {
+        using ops = detail::undo_record_ops< Func >;
+        detail::undo_record* rec = static_cast< detail::undo_record* >(p);
+        rec->undo = &ops::undo;
+        rec->destroy = &ops::destroy;
+        m_log.push(rec, ops::size, !std::is_trivially_destructible< Func >::value);
+    }
+//! \endcond
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_TRANSACTION_SCOPE_HPP_INCLUDED_
@@ -0,0 +1,97 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/tsc_clock.hpp
+ *
+ * This header contains definition of \c tsc_clock type.
+ */
+
+#ifndef BOOST_SCOPE_TSC_CLOCK_HPP_INCLUDED_
+#define BOOST_SCOPE_TSC_CLOCK_HPP_INCLUDED_
+
+#include <cstdint>
+#include <ratio>
+#include <chrono>
+#include <boost/scope/detail/config.hpp>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64)) && !defined(__clang__)
+#include <intrin.h>
+#define BOOST_SCOPE_DETAIL_TSC_CLOCK_MSVC_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#define BOOST_SCOPE_DETAIL_TSC_CLOCK_GCC_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define BOOST_SCOPE_DETAIL_TSC_CLOCK_GCC_CNTVCT
+#endif
+
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief A low-overhead clock based on the CPU timestamp counter.
+ *
+ * On x86 targets, the clock reads the TSC register with the \c rdtsc instruction. On AArch64,
+ * it reads the virtual counter register \c cntvct_el0. On other targets, the clock falls back
+ * to \c std::chrono::steady_clock, with one tick corresponding to one nanosecond.
+ *
+ * The clock is intended for measuring short durations with minimal overhead. Durations
+ * produced by the clock are measured in counter ticks. The tick frequency depends on the hardware
+ * and is not known at compile time, so the clock declares \c period as `std::ratio< 1 >`, i.e.
+ * one unit of \c duration is one tick. Durations of this clock must not be converted to other
+ * \c std::chrono duration types with \c std::chrono::duration_cast, as the result would not be
+ * measured in seconds. Users that need durations in time units must calibrate the tick frequency
+ * and convert tick counts explicitly. Also, the counter may not be synchronized between different
+ * CPUs, and the clock is not guaranteed to be steady.
+ */
+struct tsc_clock
+{
+    //! Tick count type
+    using rep = std::uint64_t;
+    //! Tick period. One unit of \c duration is one counter tick, not one second.
+    using period = std::ratio< 1 >;
+    //! Duration type
+    using duration = std::chrono::duration< rep, period >;
+    //! Time point type
+    using time_point = std::chrono::time_point< tsc_clock, duration >;
+
+    //! Indicates whether the clock is steady
+    static BOOST_CONSTEXPR_OR_CONST bool is_steady = false;
+
+    /*!
+     * \brief Returns the current value of the counter.
+     *
+     * **Throws:** Nothing.
+     */
+    static time_point now() noexcept
+    {
+#if defined(BOOST_SCOPE_DETAIL_TSC_CLOCK_MSVC_RDTSC)
+        return time_point(duration(static_cast< rep >(__rdtsc())));
+#elif defined(BOOST_SCOPE_DETAIL_TSC_CLOCK_GCC_RDTSC)
+        return time_point(duration(static_cast< rep >(__builtin_ia32_rdtsc())));
+#elif defined(BOOST_SCOPE_DETAIL_TSC_CLOCK_GCC_CNTVCT)
+        rep value;
+        __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (value));
+        return time_point(duration(value));
+#else
+        return time_point(duration(static_cast< rep >(std::chrono::duration_cast< std::chrono::nanoseconds >(
+            std::chrono::steady_clock::now().time_since_epoch()).count())));
+#endif
+    }
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_TSC_CLOCK_HPP_INCLUDED_
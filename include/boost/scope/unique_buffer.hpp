@@ -0,0 +1,108 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/unique_buffer.hpp
+ *
+ * This header contains definition of \c unique_buffer and \c unique_malloc_buffer
+ * types, which own raw memory buffers and deallocate them with sized deleters.
+ */
+
+#ifndef BOOST_SCOPE_UNIQUE_BUFFER_HPP_INCLUDED_
+#define BOOST_SCOPE_UNIQUE_BUFFER_HPP_INCLUDED_
+
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <boost/scope/unique_resource.hpp>
+#include <boost/scope/sized_deleter.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief Raw memory buffer resource traits.
+ *
+ * Since sized deleters store the size and alignment of a particular buffer, the traits disable
+ * \c unique_resource::reset overloads that replace the buffer but keep the deleter. Use the \c reset
+ * overloads that accept a deleter instead.
+ */
+struct buffer_resource_traits
+{
+    //! Indicates that the deleter is specific to the owned buffer
+    static BOOST_CONSTEXPR_OR_CONST bool deleter_bound_to_resource = true;
+
+    //! Creates a default buffer pointer value
+    static void* make_default() noexcept
+    {
+        return nullptr;
+    }
+
+    //! Tests if the buffer pointer is allocated (not null)
+    static bool is_allocated(void* p) noexcept
+    {
+        return p != nullptr;
+    }
+};
+
+//! Unique raw memory buffer allocated with \c operator \c new
+using unique_buffer = unique_resource< void*, sized_deleter, buffer_resource_traits >;
+
+//! Unique raw memory buffer allocated with \c std::malloc
+using unique_malloc_buffer = unique_resource< void*, sized_free_deleter, buffer_resource_traits >;
+
+/*!
+ * \brief Allocates a raw memory buffer.
+ *
+ * **Requires:** \a alignment is a power of 2.
+ *
+ * **Effects:** Allocates memory with `operator new(size, std::align_val_t(alignment))`, if the alignment exceeds
+ *              \c __STDCPP_DEFAULT_NEW_ALIGNMENT__, or `operator new(size)` otherwise. The returned buffer will
+ *              deallocate the memory with \c sized_deleter.
+ *
+ * **Throws:** \c std::bad_alloc if memory allocation fails or if the alignment exceeds \c __STDCPP_DEFAULT_NEW_ALIGNMENT__
+ *             and aligned allocation is not supported by the compiler. If exceptions are disabled, the program is aborted
+ *             instead of throwing.
+ *
+ * \param size Buffer size, in bytes.
+ * \param alignment Buffer alignment, in bytes.
+ * \returns The allocated buffer.
+ */
+inline unique_buffer make_unique_buffer(std::size_t size, std::size_t alignment = detail::default_new_alignment)
+{
+    void* p;
+    if (alignment > detail::default_new_alignment)
+    {
+#if defined(__cpp_aligned_new) && __cpp_aligned_new >= 201606l
+        p = ::operator new(size, static_cast< std::align_val_t >(alignment));
+#elif !defined(BOOST_NO_EXCEPTIONS)
+        throw std::bad_alloc();
+#else
+        // Mirror the behavior of operator new failing with exceptions disabled
+        std::abort();
+#endif
+    }
+    else
+    {
+        p = ::operator new(size);
+    }
+
+    return unique_buffer(p, sized_deleter(size, alignment));
+}
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // BOOST_SCOPE_UNIQUE_BUFFER_HPP_INCLUDED_
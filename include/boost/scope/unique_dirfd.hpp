@@ -0,0 +1,246 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/unique_dirfd.hpp
+ *
+ * This header contains definition of \c unique_dirfd type and functions for performing
+ * file system operations relative to a directory file descriptor.
+ *
+ * The components are only available on POSIX systems.
+ */
+
+#ifndef BOOST_SCOPE_UNIQUE_DIRFD_HPP_INCLUDED_
+#define BOOST_SCOPE_UNIQUE_DIRFD_HPP_INCLUDED_
+
+#include <boost/scope/detail/config.hpp>
+
+#if !defined(BOOST_WINDOWS)
+
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/fd_factories.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+/*!
+ * \brief Unique directory file descriptor.
+ *
+ * This is an alias for \c unique_fd, which is intended to hold file descriptors of directories. The file descriptor
+ * can be used as the base for resolving relative paths in \c open_at and other functions declared in this header.
+ */
+using unique_dirfd = unique_fd;
+
+//! \cond
+namespace detail {
+
+#if defined(O_DIRECTORY)
+BOOST_CONSTEXPR_OR_CONST int open_dir_flags = O_RDONLY | O_DIRECTORY;
+#else
+BOOST_CONSTEXPR_OR_CONST int open_dir_flags = O_RDONLY;
+#endif
+
+//! Converts the result of a system call that returns 0 on success to an error code
+inline void set_syscall_result(int res, std::error_code& ec) noexcept
+{
+    if (BOOST_UNLIKELY(res != 0))
+        ec = last_fd_error();
+    else
+        ec.clear();
+}
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Opens a file relative to a directory.
+ *
+ * **Effects:** Calls `openat(dir.get(), path, flags | O_CLOEXEC, mode)`, retrying if the call is interrupted by a signal.
+ *              If \a path is absolute, \a dir is ignored.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param dir Directory file descriptor.
+ * \param path File name, relative to \a dir.
+ * \param flags File open flags, as accepted by \c open.
+ * \param mode File permissions, if a new file is created.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The opened file descriptor. If an error occurs, the returned \c unique_fd does not hold a file descriptor.
+ */
+inline unique_fd open_at(unique_dirfd const& dir, const char* path, int flags, mode_t mode, std::error_code& ec) noexcept
+{
+    int fd;
+#if defined(O_CLOEXEC)
+    flags |= O_CLOEXEC;
+#endif
+    while (true)
+    {
+        fd = ::openat(dir.get(), path, flags, mode);
+        if (BOOST_LIKELY(fd >= 0) || errno != EINTR)
+            break;
+    }
+
+    unique_fd res = detail::make_unique_fd(fd, ec);
+#if !defined(O_CLOEXEC)
+    detail::set_cloexec(res, ec);
+#endif
+    return res;
+}
+
+/*!
+ * \brief Opens a file relative to a directory.
+ *
+ * **Effects:** Equivalent to `open_at(dir, path, flags, 0, ec)`.
+ */
+inline unique_fd open_at(unique_dirfd const& dir, const char* path, int flags, std::error_code& ec) noexcept
+{
+    return open_at(dir, path, flags, static_cast< mode_t >(0), ec);
+}
+
+/*!
+ * \brief Opens a directory.
+ *
+ * **Effects:** Calls `open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC)`.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param path Directory name.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The opened directory file descriptor. If an error occurs, the returned object does not hold a file descriptor.
+ */
+inline unique_dirfd open_dir(const char* path, std::error_code& ec) noexcept
+{
+    return open_fd(path, detail::open_dir_flags, ec);
+}
+
+/*!
+ * \brief Opens a directory relative to another directory.
+ *
+ * **Effects:** Calls `openat(dir.get(), path, O_RDONLY | O_DIRECTORY | O_CLOEXEC)`.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param dir Parent directory file descriptor.
+ * \param path Directory name, relative to \a dir.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ * \returns The opened directory file descriptor. If an error occurs, the returned object does not hold a file descriptor.
+ */
+inline unique_dirfd open_dir_at(unique_dirfd const& dir, const char* path, std::error_code& ec) noexcept
+{
+    return open_at(dir, path, detail::open_dir_flags, ec);
+}
+
+/*!
+ * \brief Obtains file status relative to a directory.
+ *
+ * **Effects:** Calls `fstatat(dir.get(), path, &st, flags)`.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param dir Directory file descriptor.
+ * \param path File name, relative to \a dir.
+ * \param st Structure to receive the file status.
+ * \param flags Flags, e.g. \c AT_SYMLINK_NOFOLLOW.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ */
+inline void stat_at(unique_dirfd const& dir, const char* path, struct stat& st, int flags, std::error_code& ec) noexcept
+{
+    detail::set_syscall_result(::fstatat(dir.get(), path, &st, flags), ec);
+}
+
+/*!
+ * \brief Obtains file status relative to a directory.
+ *
+ * **Effects:** Equivalent to `stat_at(dir, path, st, 0, ec)`.
+ */
+inline void stat_at(unique_dirfd const& dir, const char* path, struct stat& st, std::error_code& ec) noexcept
+{
+    stat_at(dir, path, st, 0, ec);
+}
+
+/*!
+ * \brief Removes a file or a directory relative to a directory.
+ *
+ * **Effects:** Calls `unlinkat(dir.get(), path, flags)`.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param dir Directory file descriptor.
+ * \param path File name, relative to \a dir.
+ * \param flags Flags. If \c AT_REMOVEDIR is specified, removes an empty directory.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ */
+inline void unlink_at(unique_dirfd const& dir, const char* path, int flags, std::error_code& ec) noexcept
+{
+    detail::set_syscall_result(::unlinkat(dir.get(), path, flags), ec);
+}
+
+/*!
+ * \brief Removes a file relative to a directory.
+ *
+ * **Effects:** Equivalent to `unlink_at(dir, path, 0, ec)`.
+ */
+inline void unlink_at(unique_dirfd const& dir, const char* path, std::error_code& ec) noexcept
+{
+    unlink_at(dir, path, 0, ec);
+}
+
+/*!
+ * \brief Renames a file, with the file names resolved relative to directories.
+ *
+ * **Effects:** Calls `renameat(old_dir.get(), old_path, new_dir.get(), new_path)`.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param old_dir Directory file descriptor for \a old_path.
+ * \param old_path Current file name, relative to \a old_dir.
+ * \param new_dir Directory file descriptor for \a new_path.
+ * \param new_path New file name, relative to \a new_dir.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ */
+inline void rename_at(unique_dirfd const& old_dir, const char* old_path, unique_dirfd const& new_dir, const char* new_path, std::error_code& ec) noexcept
+{
+    detail::set_syscall_result(::renameat(old_dir.get(), old_path, new_dir.get(), new_path), ec);
+}
+
+/*!
+ * \brief Creates a directory relative to a directory.
+ *
+ * **Effects:** Calls `mkdirat(dir.get(), path, mode)`.
+ *
+ * **Throws:** Nothing.
+ *
+ * \param dir Parent directory file descriptor.
+ * \param path Name of the directory to create, relative to \a dir.
+ * \param mode Directory permissions.
+ * \param ec Error code. Cleared on success and set to the error reported by the system on failure.
+ */
+inline void mkdir_at(unique_dirfd const& dir, const char* path, mode_t mode, std::error_code& ec) noexcept
+{
+    detail::set_syscall_result(::mkdirat(dir.get(), path, mode), ec);
+}
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // !defined(BOOST_WINDOWS)
+
+#endif // BOOST_SCOPE_UNIQUE_DIRFD_HPP_INCLUDED_
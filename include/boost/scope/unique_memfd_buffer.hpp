@@ -0,0 +1,429 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file scope/unique_memfd_buffer.hpp
+ *
+ * This header contains definition of \c unique_memfd_buffer, which owns a memory-backed
+ * file and its memory mapping.
+ *
+ * The components are only available on Linux.
+ */
+
+#ifndef BOOST_SCOPE_UNIQUE_MEMFD_BUFFER_HPP_INCLUDED_
+#define BOOST_SCOPE_UNIQUE_MEMFD_BUFFER_HPP_INCLUDED_
+
+#include <boost/scope/detail/config.hpp>
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <cstddef>
+#include <system_error>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/fd_factories.hpp>
+#include <boost/scope/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+namespace scope {
+
+//! \cond
+namespace detail {
+
+// Constants from linux/fcntl.h and linux/memfd.h, which may not be defined by older C libraries
+#if defined(F_ADD_SEALS)
+BOOST_CONSTEXPR_OR_CONST int memfd_add_seals = F_ADD_SEALS;
+BOOST_CONSTEXPR_OR_CONST int memfd_get_seals = F_GET_SEALS;
+BOOST_CONSTEXPR_OR_CONST int memfd_seal_shrink = F_SEAL_SHRINK;
+BOOST_CONSTEXPR_OR_CONST int memfd_seal_grow = F_SEAL_GROW;
+BOOST_CONSTEXPR_OR_CONST int memfd_seal_write = F_SEAL_WRITE;
+#else
+BOOST_CONSTEXPR_OR_CONST int memfd_add_seals = 1024 + 9;
+BOOST_CONSTEXPR_OR_CONST int memfd_get_seals = 1024 + 10;
+BOOST_CONSTEXPR_OR_CONST int memfd_seal_shrink = 0x0002;
+BOOST_CONSTEXPR_OR_CONST int memfd_seal_grow = 0x0004;
+BOOST_CONSTEXPR_OR_CONST int memfd_seal_write = 0x0008;
+#endif
+
+BOOST_CONSTEXPR_OR_CONST unsigned int memfd_allow_sealing = 0x0002u;
+BOOST_CONSTEXPR_OR_CONST unsigned int memfd_hugetlb = 0x0004u;
+
+} // namespace detail
+//! \endcond
+
+//! Options for creating and mapping \c unique_memfd_buffer
+enum class memfd_buffer_options : unsigned int
+{
+    //! No options
+    none = 0u,
+    //! Prefault the mapped pages (\c MAP_POPULATE)
+    populate = 1u,
+    //! Back the file with huge pages (\c MFD_HUGETLB). The size must be a multiple of the huge page size.
+    huge_pages = 2u,
+    //! Allow \c unique_memfd_buffer::map to map files that are not sealed against writing and shrinking
+    allow_unsealed = 4u
+};
+
+//! Combines options
+BOOST_CONSTEXPR inline memfd_buffer_options operator| (memfd_buffer_options left, memfd_buffer_options right) noexcept
+{
+    return static_cast< memfd_buffer_options >(static_cast< unsigned int >(left) | static_cast< unsigned int >(right));
+}
+
+//! Intersects options
+BOOST_CONSTEXPR inline memfd_buffer_options operator& (memfd_buffer_options left, memfd_buffer_options right) noexcept
+{
+    return static_cast< memfd_buffer_options >(static_cast< unsigned int >(left) & static_cast< unsigned int >(right));
+}
+
+/*!
+ * \brief Memory-backed file with a shared memory mapping.
+ *
+ * The object owns a memory-backed file descriptor, created with \c memfd_create, and a shared mapping of
+ * the file contents. The buffer can be used to share data between processes on the same host without
+ * copying. The producer creates the buffer with \c create, fills it with data and calls \c seal, which
+ * makes the file contents immutable and remaps the buffer read-only. The file descriptor can then be passed
+ * to consumers (e.g. with \c send_fds), which map it read-only with \c map. Since the file is sealed,
+ * the consumers can rely on the data not being modified or truncated by the producer.
+ *
+ * On destruction, the mapping is removed and the file descriptor is closed.
+ */
+class unique_memfd_buffer
+{
+//! \cond
+private:
+    unique_fd m_fd;
+    void* m_data;
+    std::size_t m_size;
+    bool m_writable;
+
+//! \endcond
+public:
+    /*!
+     * \brief Constructs an empty buffer.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post `this->empty() == true`
+     */
+    unique_memfd_buffer() noexcept :
+        m_data(nullptr),
+        m_size(0u),
+        m_writable(false)
+    {
+    }
+
+    /*!
+     * \brief Move-constructs a buffer.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post \a that is empty.
+     */
+    unique_memfd_buffer(unique_memfd_buffer&& that) noexcept :
+        m_fd(static_cast< unique_fd&& >(that.m_fd)),
+        m_data(that.m_data),
+        m_size(that.m_size),
+        m_writable(that.m_writable)
+    {
+        that.m_data = nullptr;
+        that.m_size = 0u;
+        that.m_writable = false;
+    }
+
+    /*!
+     * \brief Move-assigns a buffer.
+     *
+     * **Effects:** Frees the buffer owned by `*this`, if any, and takes ownership of the buffer owned by \a that.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post \a that is empty.
+     */
+    unique_memfd_buffer& operator= (unique_memfd_buffer&& that) noexcept
+    {
+        if (this != &that)
+        {
+            reset();
+            m_fd = static_cast< unique_fd&& >(that.m_fd);
+            m_data = that.m_data;
+            m_size = that.m_size;
+            m_writable = that.m_writable;
+            that.m_data = nullptr;
+            that.m_size = 0u;
+            that.m_writable = false;
+        }
+
+        return *this;
+    }
+
+    unique_memfd_buffer(unique_memfd_buffer const&) = delete;
+    unique_memfd_buffer& operator= (unique_memfd_buffer const&) = delete;
+
+    /*!
+     * \brief Removes the mapping and closes the file descriptor.
+     *
+     * **Throws:** Nothing.
+     */
+    ~unique_memfd_buffer()
+    {
+        unmap();
+    }
+
+    /*!
+     * \brief Creates a memory-backed file of the given size and maps it for reading and writing.
+     *
+     * **Effects:** Creates a file with \c memfd_create, with sealing allowed and the close-on-exec flag set, sets
+     *              its size to \a size and maps it with `PROT_READ | PROT_WRITE` and \c MAP_SHARED.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param name Name of the file, for debugging purposes.
+     * \param size Size of the buffer, in bytes. Must not be zero.
+     * \param ec Error code. Cleared on success and set to the error reported by the system on failure. If \a size
+     *           is zero, set to \c std::errc::invalid_argument.
+     * \param options Creation and mapping options.
+     * \returns The created buffer. If an error occurs, the returned buffer is empty.
+     */
+    static unique_memfd_buffer create(const char* name, std::size_t size, std::error_code& ec, memfd_buffer_options options = memfd_buffer_options::none) noexcept
+    {
+        if (BOOST_UNLIKELY(size == 0u))
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return unique_memfd_buffer();
+        }
+
+        unsigned int memfd_flags = detail::memfd_allow_sealing;
+        if ((options & memfd_buffer_options::huge_pages) != memfd_buffer_options::none)
+            memfd_flags |= detail::memfd_hugetlb;
+
+        unique_memfd_buffer buf;
+        buf.m_fd = memfd_fd(name, memfd_flags, ec);
+        if (BOOST_UNLIKELY(!!ec))
+            return buf;
+
+        if (BOOST_UNLIKELY(::ftruncate(buf.m_fd.get(), static_cast< off_t >(size)) != 0))
+        {
+            ec = detail::last_fd_error();
+            buf.m_fd.reset();
+            return buf;
+        }
+
+        if (BOOST_UNLIKELY(!buf.map_impl(size, true, options, ec)))
+            buf.m_fd.reset();
+        return buf;
+    }
+
+    /*!
+     * \brief Maps an existing memory-backed file read-only.
+     *
+     * **Effects:** Verifies that the file is sealed with \c F_SEAL_WRITE and \c F_SEAL_SHRINK, determines the size of
+     *              the file and maps it with \c PROT_READ and \c MAP_SHARED. The buffer takes ownership of the file
+     *              descriptor. This is intended to be used by the consumers of the buffer, who receive the file descriptor
+     *              from the producer. The seals guarantee that the producer cannot modify or truncate the file, which would
+     *              otherwise cause \c SIGBUS on access to the mapping. The seals are not checked if
+     *              \c memfd_buffer_options::allow_unsealed is specified.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param fd Memory-backed file descriptor.
+     * \param ec Error code. Cleared on success and set to the error reported by the system on failure. If the file
+     *           is not sealed, set to \c std::errc::operation_not_permitted.
+     * \param options Mapping options. \c memfd_buffer_options::huge_pages is ignored.
+     * \returns The mapped buffer. If an error occurs, the returned buffer is empty and \a fd is closed.
+     */
+    static unique_memfd_buffer map(unique_fd fd, std::error_code& ec, memfd_buffer_options options = memfd_buffer_options::none) noexcept
+    {
+        unique_memfd_buffer buf;
+        if ((options & memfd_buffer_options::allow_unsealed) == memfd_buffer_options::none)
+        {
+            const int required_seals = detail::memfd_seal_write | detail::memfd_seal_shrink;
+            const int seals = ::fcntl(fd.get(), detail::memfd_get_seals);
+            if (BOOST_UNLIKELY(seals < 0))
+            {
+                ec = detail::last_fd_error();
+                return buf;
+            }
+
+            if (BOOST_UNLIKELY((seals & required_seals) != required_seals))
+            {
+                ec = std::make_error_code(std::errc::operation_not_permitted);
+                return buf;
+            }
+        }
+
+        struct stat st = {};
+        if (BOOST_UNLIKELY(::fstat(fd.get(), &st) != 0))
+        {
+            ec = detail::last_fd_error();
+            return buf;
+        }
+
+        buf.m_fd = static_cast< unique_fd&& >(fd);
+        if (BOOST_UNLIKELY(!buf.map_impl(static_cast< std::size_t >(st.st_size), false, options, ec)))
+            buf.m_fd.reset();
+        return buf;
+    }
+
+    /*!
+     * \brief Seals the file contents and remaps the buffer read-only.
+     *
+     * **Effects:** Removes the writable mapping, adds `F_SEAL_WRITE | F_SEAL_SHRINK | F_SEAL_GROW` seals to the file
+     *              and maps it read-only. After sealing, the file contents cannot be modified by any process. The new
+     *              mapping may be located at a different address, so pointers obtained from `this->data()` before the call
+     *              are invalidated.
+     *
+     * **Requires:** `this->empty() == false`.
+     *
+     * **Throws:** Nothing.
+     *
+     * \param ec Error code. Cleared on success and set to the error reported by the system on failure. If adding
+     *           the seals fails, \a ec is set to that error and the previous mapping is restored, possibly at a different
+     *           address. If mapping the buffer fails, either after sealing or when restoring the previous mapping, \a ec is
+     *           set to the mapping error, the buffer retains the file descriptor but is left unmapped, and `this->data()`
+     *           returns \c nullptr.
+     * \param options Mapping options for the read-only mapping.
+     *
+     * \post `this->writable() == false` on success.
+     */
+    void seal(std::error_code& ec, memfd_buffer_options options = memfd_buffer_options::none) noexcept
+    {
+        // F_SEAL_WRITE cannot be added while there are writable shared mappings of the file
+        const std::size_t size = m_size;
+        const bool was_writable = m_writable;
+        unmap();
+
+        if (BOOST_UNLIKELY(::fcntl(m_fd.get(), detail::memfd_add_seals, detail::memfd_seal_write | detail::memfd_seal_shrink | detail::memfd_seal_grow) != 0))
+        {
+            ec = detail::last_fd_error();
+            std::error_code map_ec;
+            if (BOOST_UNLIKELY(!map_impl(size, was_writable, options, map_ec)))
+                ec = map_ec;
+            return;
+        }
+
+        map_impl(size, false, options, ec);
+    }
+
+    /*!
+     * \brief Returns \c true if the file is sealed against writing.
+     *
+     * **Throws:** Nothing.
+     */
+    bool sealed() const noexcept
+    {
+        const int seals = ::fcntl(m_fd.get(), detail::memfd_get_seals);
+        return seals > 0 && (seals & detail::memfd_seal_write) != 0;
+    }
+
+    /*!
+     * \brief Removes the mapping and closes the file descriptor.
+     *
+     * **Throws:** Nothing.
+     *
+     * \post `this->empty() == true`
+     */
+    void reset() noexcept
+    {
+        unmap();
+        m_fd.reset();
+    }
+
+    //! Returns \c true if the buffer does not own a file descriptor
+    bool empty() const noexcept
+    {
+        return !m_fd.allocated();
+    }
+
+    //! Returns \c true if the buffer owns a file descriptor
+    explicit operator bool () const noexcept
+    {
+        return m_fd.allocated();
+    }
+
+    //! Returns a pointer to the mapped buffer or \c nullptr if the buffer is not mapped
+    void* data() const noexcept
+    {
+        return m_data;
+    }
+
+    //! Returns the buffer size, in bytes
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    //! Returns \c true if the buffer is mapped for writing
+    bool writable() const noexcept
+    {
+        return m_writable;
+    }
+
+    //! Returns the memory-backed file descriptor
+    unique_fd const& fd() const noexcept
+    {
+        return m_fd;
+    }
+
+//! \cond
+private:
+    //! Maps the file, returns \c false on failure
+    bool map_impl(std::size_t size, bool writable, memfd_buffer_options options, std::error_code& ec) noexcept
+    {
+        int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+        if ((options & memfd_buffer_options::populate) != memfd_buffer_options::none)
+            flags |= MAP_POPULATE;
+#else
+        static_cast< void >(options);
+#endif
+
+        void* p = ::mmap(nullptr, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, flags, m_fd.get(), 0);
+        if (BOOST_UNLIKELY(p == MAP_FAILED))
+        {
+            ec = detail::last_fd_error();
+            return false;
+        }
+
+        ec.clear();
+        m_data = p;
+        m_size = size;
+        m_writable = writable;
+        return true;
+    }
+
+    void unmap() noexcept
+    {
+        if (m_data)
+        {
+            ::munmap(m_data, m_size);
+            m_data = nullptr;
+        }
+
+        m_size = 0u;
+        m_writable = false;
+    }
+//! \endcond
+};
+
+} // namespace scope
+} // namespace boost
+
+#include <boost/scope/detail/footer.hpp>
+
+#endif // defined(__linux__)
+
+#endif // BOOST_SCOPE_UNIQUE_MEMFD_BUFFER_HPP_INCLUDED_
@@ -15,21 +15,31 @@
 #define BOOST_SCOPE_UNIQUE_RESOURCE_HPP_INCLUDED_
 
 #include <new> // for placement new
+#include <cstddef>
+#include <functional> // std::hash
 #include <type_traits>
 #include <boost/core/addressof.hpp>
+#include <boost/core/no_exceptions_support.hpp>
 #include <boost/core/invoke_swap.hpp>
 #include <boost/scope/unique_resource_fwd.hpp>
+#include <boost/scope/fast_teardown.hpp>
+#include <boost/scope/is_trivially_relocatable.hpp>
 #include <boost/scope/detail/config.hpp>
 #include <boost/scope/detail/compact_storage.hpp>
 #include <boost/scope/detail/move_or_copy_assign_ref.hpp>
 #include <boost/scope/detail/move_or_copy_construct_ref.hpp>
 #include <boost/scope/detail/is_nonnull_default_constructible.hpp>
+#include <boost/scope/detail/resource_instrumentation.hpp>
 #include <boost/scope/detail/type_traits/is_swappable.hpp>
 #include <boost/scope/detail/type_traits/is_nothrow_swappable.hpp>
+#include <boost/scope/detail/type_traits/is_invocable.hpp>
 #include <boost/scope/detail/type_traits/is_nothrow_invocable.hpp>
 #include <boost/scope/detail/type_traits/negation.hpp>
 #include <boost/scope/detail/type_traits/conjunction.hpp>
 #include <boost/scope/detail/type_traits/disjunction.hpp>
+#if defined(BOOST_SCOPE_DETAIL_HAS_THREE_WAY_COMPARISON)
+#include <compare>
+#endif
 #include <boost/scope/detail/header.hpp>
 
 #ifdef BOOST_HAS_PRAGMA_ONCE
@@ -220,15 +230,17 @@ private:
     }
 
     template< typename R, typename D >
-    explicit resource_holder(R&& res, D&& del, bool allocated, std::false_type) try :
+    explicit resource_holder(R&& res, D&& del, bool allocated, std::false_type) BOOST_SCOPE_DETAIL_FUNCTION_TRY :
         resource_base(res)
     {
     }
+#if !defined(BOOST_NO_EXCEPTIONS)
     catch (...)
     {
         if (allocated)
             del(res);
     }
+#endif
 };
 
 template< typename Resource >
@@ -307,15 +319,17 @@ private:
     }
 
     template< typename R, typename D >
-    explicit resource_holder(R&& res, D&& del, bool allocated, std::false_type) try :
+    explicit resource_holder(R&& res, D&& del, bool allocated, std::false_type) BOOST_SCOPE_DETAIL_FUNCTION_TRY :
         m_resource(res)
     {
     }
+#if !defined(BOOST_NO_EXCEPTIONS)
     catch (...)
     {
         if (allocated)
             del(res);
     }
+#endif
 };
 
 template< typename Resource, typename Deleter >
@@ -386,15 +400,17 @@ private:
     }
 
     template< typename D >
-    explicit deleter_holder(D&& del, resource_type& res, bool allocated, std::false_type) try :
+    explicit deleter_holder(D&& del, resource_type& res, bool allocated, std::false_type) BOOST_SCOPE_DETAIL_FUNCTION_TRY :
         deleter_base(del)
     {
     }
+#if !defined(BOOST_NO_EXCEPTIONS)
     catch (...)
     {
         if (BOOST_LIKELY(allocated))
             del(res);
     }
+#endif
 };
 
 /*
@@ -643,18 +659,20 @@ private:
         that.set_unallocated();
     }
 
-    unique_resource_data(unique_resource_data&& that, std::true_type, std::false_type) try :
+    unique_resource_data(unique_resource_data&& that, std::true_type, std::false_type) BOOST_SCOPE_DETAIL_FUNCTION_TRY :
         resource_holder(static_cast< typename detail::move_or_copy_construct_ref< resource_type >::type >(that.get_resource())),
         deleter_holder(static_cast< deleter_type const& >(that.get_deleter()))
     {
         that.set_unallocated();
     }
+#if !defined(BOOST_NO_EXCEPTIONS)
     catch (...)
     {
         // Since only the deleter's constructor could have thrown an exception here, move the resource back
         // to the original unique_resource. This is guaranteed to not throw.
         that.resource_holder::move_from(static_cast< internal_resource_type&& >(resource_holder::get_internal()));
     }
+#endif
 
     unique_resource_data(unique_resource_data&& that, std::false_type, std::false_type) :
         resource_holder(static_cast< resource_type const& >(that.get_resource())),
@@ -927,19 +945,21 @@ private:
         that.m_allocated = false;
     }
 
-    unique_resource_data(unique_resource_data&& that, std::true_type, std::false_type) try :
+    unique_resource_data(unique_resource_data&& that, std::true_type, std::false_type) BOOST_SCOPE_DETAIL_FUNCTION_TRY :
         resource_holder(static_cast< typename detail::move_or_copy_construct_ref< resource_type >::type >(that.get_resource())),
         deleter_holder(static_cast< deleter_type const& >(that.get_deleter())),
         m_allocated(that.m_allocated)
     {
         that.m_allocated = false;
     }
+#if !defined(BOOST_NO_EXCEPTIONS)
     catch (...)
     {
         // Since only the deleter's constructor could have thrown an exception here, move the resource back
         // to the original unique_resource. This is guaranteed to not throw.
         that.resource_holder::move_from(static_cast< internal_resource_type&& >(resource_holder::get_internal()));
     }
+#endif
 
     unique_resource_data(unique_resource_data&& that, std::false_type, std::false_type) :
         resource_holder(static_cast< resource_type const& >(that.get_resource())),
@@ -1053,6 +1073,86 @@ struct dereference_traits< T, true >
     static constexpr bool is_noexcept = noexcept(*std::declval< T const& >());
 };
 
+//! The type trait indicates whether objects of types \c T and \c U can be compared for equality
+template< typename T, typename U = T >
+struct is_equality_comparable_impl
+{
+    template< typename T1, typename U1, typename R = decltype(std::declval< T1 const& >() == std::declval< U1 const& >()) >
+    static std::true_type _is_equality_comparable_check(int);
+    template< typename T1, typename U1 >
+    static std::false_type _is_equality_comparable_check(...);
+
+    using type = decltype(is_equality_comparable_impl::_is_equality_comparable_check< T, U >(0));
+};
+
+template< typename T, typename U = T >
+struct is_equality_comparable : public is_equality_comparable_impl< T, U >::type { };
+
+//! The type trait indicates whether objects of types \c T and \c U can be compared with \c operator<
+template< typename T, typename U = T >
+struct is_less_than_comparable_impl
+{
+    template< typename T1, typename U1, typename R = decltype(std::declval< T1 const& >() < std::declval< U1 const& >()) >
+    static std::true_type _is_less_than_comparable_check(int);
+    template< typename T1, typename U1 >
+    static std::false_type _is_less_than_comparable_check(...);
+
+    using type = decltype(is_less_than_comparable_impl::_is_less_than_comparable_check< T, U >(0));
+};
+
+template< typename T, typename U = T >
+struct is_less_than_comparable : public is_less_than_comparable_impl< T, U >::type { };
+
+template< typename T, bool = detail::is_equality_comparable< T >::value >
+struct is_nothrow_equality_comparable : public std::false_type { };
+template< typename T >
+struct is_nothrow_equality_comparable< T, true > :
+    public std::integral_constant< bool, noexcept(std::declval< T const& >() == std::declval< T const& >()) >
+{
+};
+
+template< typename T, bool = detail::is_less_than_comparable< T >::value >
+struct is_nothrow_less_than_comparable : public std::false_type { };
+template< typename T >
+struct is_nothrow_less_than_comparable< T, true > :
+    public std::integral_constant< bool, noexcept(std::declval< T const& >() < std::declval< T const& >()) >
+{
+};
+
+//! The type trait indicates whether \c unique_resource is trivially relocatable
+template< typename Resource, typename Deleter, typename Traits >
+struct is_unique_resource_trivially_relocatable :
+    public detail::conjunction<
+        is_trivially_relocatable< typename wrap_reference< Resource >::type >,
+        is_trivially_relocatable< typename wrap_reference< Deleter >::type >,
+        // Instrumentation identifies resources by the address of unique_resource, so relocation must notify it
+        std::integral_constant< bool, !resource_instrumentation< Traits >::enabled >
+    >::type
+{
+};
+
+template< typename Traits >
+struct is_deleter_bound_to_resource_impl
+{
+    template< typename T, bool Value = T::deleter_bound_to_resource >
+    static std::integral_constant< bool, Value > _is_deleter_bound_to_resource_check(int);
+    template< typename T >
+    static std::false_type _is_deleter_bound_to_resource_check(...);
+
+    using type = decltype(is_deleter_bound_to_resource_impl::_is_deleter_bound_to_resource_check< Traits >(0));
+};
+
+/*!
+ * The type trait indicates whether the deleter state is specific to the owned resource, so that the resource
+ * cannot be replaced without replacing the deleter. This is the case if the traits define a static constant
+ * \c deleter_bound_to_resource that is \c true.
+ */
+template< typename Traits >
+struct is_deleter_bound_to_resource : public is_deleter_bound_to_resource_impl< Traits >::type { };
+
+template< >
+struct is_deleter_bound_to_resource< void > : public std::false_type { };
+
 } // namespace detail
 
 /*!
@@ -1095,6 +1195,46 @@ struct dereference_traits< T, true >
  *
  * Note that `is_allocated(make_default())` must always return \c false.
  *
+ * Resource traits may optionally define a nested \c instrumentation type, which
+ * enables instrumentation of the \c unique_resource objects using the traits.
+ * The instrumentation type must have the following public static members:
+ *
+ * \li `void on_acquire(const void* owner, Resource const& res) noexcept` - called
+ *     when \c unique_resource object pointed to by \c owner takes ownership of
+ *     the resource \c res. Alternatively, the instrumentation may define
+ *     `void on_acquire(const void* owner, Resource const& res, resource_site const& site) noexcept`,
+ *     which additionally receives the source location where the resource was acquired.
+ * \li `void on_release(const void* owner, Resource const& res) noexcept` - called
+ *     when \c unique_resource object pointed to by \c owner relinquishes
+ *     ownership of \c res without calling the deleter on it.
+ * \li `void on_reset(const void* owner, Resource const& res) noexcept` - called
+ *     when \c unique_resource object pointed to by \c owner is about to call
+ *     the deleter on \c res.
+ * \li `void on_move(const void* from, const void* to, Resource const& res) noexcept` -
+ *     called when ownership of \c res is transferred from the \c unique_resource
+ *     object pointed to by \c from to the one pointed to by \c to.
+ * \li `void on_swap(const void* left, const void* right) noexcept` - called
+ *     after the \c unique_resource objects pointed to by \c left and \c right
+ *     have swapped their resources.
+ *
+ * Instrumentation can be disabled globally by defining \c BOOST_SCOPE_DISABLE_INSTRUMENTATION.
+ * When instrumentation is not enabled, \c unique_resource incurs no overhead.
+ *
+ * The constructors and \c reset taking a resource have overloads that accept an additional
+ * trailing \c resource_site argument, which is passed to the instrumentation. Typically, the
+ * argument is obtained by calling \c resource_site::current at the point of acquisition. The
+ * overloads without the argument pass an unknown location to the instrumentation.
+ *
+ * Resource traits may optionally define a static constant `bool deleter_bound_to_resource`.
+ * If it is \c true, the deleter state is specific to the owned resource object (for example,
+ * it contains the size of an allocated buffer), and \c reset overloads that replace the resource
+ * object but keep the deleter are disabled. The resource can be replaced with the \c reset
+ * overloads that also accept a deleter.
+ *
+ * Resource traits may optionally define a static constant `bool skip_deleter_on_teardown`.
+ * If it is \c true, the \c unique_resource destructor will not call the deleter after
+ * fast teardown mode is enabled by calling \c enable_fast_teardown.
+ *
  * When resource traits satisfying the above requirements are specified,
  * \c unique_resource will be able to avoid storing additional indication of
  * whether the owned resource object needs to be deallocated with the deleter
@@ -1110,7 +1250,8 @@ struct dereference_traits< T, true >
  * \tparam Traits Optional resource traits type.
  */
 template< typename Resource, typename Deleter, typename Traits BOOST_SCOPE_DETAIL_DOC(= void) >
-class unique_resource
+class BOOST_SCOPE_DETAIL_TRIVIALLY_RELOCATABLE_IF(detail::is_unique_resource_trivially_relocatable< Resource, Deleter, Traits >::value)
+unique_resource
 {
 public:
     //! Resource type
@@ -1125,6 +1266,7 @@ private:
     using data = detail::unique_resource_data< resource_type, deleter_type, traits_type >;
     using internal_resource_type = typename data::internal_resource_type;
     using internal_deleter_type = typename data::internal_deleter_type;
+    using instrumentation = detail::resource_instrumentation< traits_type >;
 
     data m_data;
 
@@ -1217,6 +1359,42 @@ public:
         //! \endcond
     >
     explicit unique_resource(R&& res)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(
+            std::is_nothrow_constructible<
+                data,
+                typename detail::move_or_copy_construct_ref< R, resource_type >::type,
+                typename detail::move_or_copy_construct_ref< deleter_type >::type
+            >::value
+        )) :
+        unique_resource(static_cast< R&& >(res), resource_site())
+    {
+    }
+
+    /*!
+     * \brief Constructs a unique resource guard with the given resource and a default-constructed deleter.
+     *
+     * **Requires:** \c Resource is constructible from \a res. \c Deleter is default-constructible and
+     *               is not a pointer to function.
+     *
+     * **Effects:** Constructs the unique resource object as if by calling
+     *              `unique_resource(std::forward< R >(res), Deleter(), site)`.
+     *
+     * **Throws:** Nothing, unless construction of \c Resource or \c Deleter throws.
+     *
+     * \param res Resource object.
+     * \param site Source location where the resource was acquired. Passed to the instrumentation.
+     */
+    template<
+        typename R
+        //! \cond
+        , typename = typename std::enable_if< detail::conjunction<
+            detail::is_nothrow_nonnull_default_constructible< deleter_type >,
+            std::is_constructible< data, typename detail::move_or_copy_construct_ref< R, resource_type >::type, typename detail::move_or_copy_construct_ref< deleter_type >::type >,
+            detail::disjunction< detail::negation< std::is_reference< resource_type > >, std::is_reference< R > > // prevent binding lvalue-reference resource to an rvalue
+        >::value >::type
+        //! \endcond
+    >
+    unique_resource(R&& res, resource_site const& site)
         noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(
             std::is_nothrow_constructible<
                 data,
@@ -1230,6 +1408,7 @@ public:
             static_cast< typename detail::move_or_copy_construct_ref< deleter_type >::type >(deleter_type())
         )
     {
+        notify_acquire(site);
     }
 
     /*!
@@ -1259,12 +1438,58 @@ public:
         typename D
         //! \cond
         , typename = typename std::enable_if< detail::conjunction<
+            detail::negation< std::is_same< typename std::decay< D >::type, resource_site > >,
             std::is_constructible< data, typename detail::move_or_copy_construct_ref< R, resource_type >::type, typename detail::move_or_copy_construct_ref< D, deleter_type >::type >,
             detail::disjunction< detail::negation< std::is_reference< resource_type > >, std::is_reference< R > > // prevent binding lvalue-reference resource to an rvalue
         >::value >::type
         //! \endcond
     >
     unique_resource(R&& res, D&& del)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(
+            std::is_nothrow_constructible<
+                data,
+                typename detail::move_or_copy_construct_ref< R, resource_type >::type,
+                typename detail::move_or_copy_construct_ref< D, deleter_type >::type
+            >::value
+        )) :
+        unique_resource(static_cast< R&& >(res), static_cast< D&& >(del), resource_site())
+    {
+    }
+
+    /*!
+     * \brief Constructs a unique resource guard with the given resource and deleter.
+     *
+     * **Requires:** \c Resource is constructible from \a res and \c Deleter is constructible from \a del.
+     *
+     * **Effects:** If \c Resource is nothrow constructible from `R&&` then constructs \c Resource
+     *              from `std::forward< R >(res)`, otherwise constructs from `res`. If \c Deleter
+     *              is nothrow constructible from `D&&` then constructs \c Deleter from
+     *              `std::forward< D >(del)`, otherwise constructs from `del`.
+     *
+     *              If construction of \c Resource or \c Deleter throws and \a res is not an unallocated resource
+     *              value, invokes \a del on \a res (if \c Resource construction failed) or the constructed
+     *              \c Resource object (if \c Deleter construction failed).
+     *
+     * **Throws:** Nothing, unless construction of \c Resource or \c Deleter throws.
+     *
+     * \param res Resource object.
+     * \param del Resource deleter function object.
+     * \param site Source location where the resource was acquired. Passed to the instrumentation.
+     *
+     * \post If \a res is an unallocated resource value then `this->allocated() == false`, otherwise
+     *       `this->allocated() == true`.
+     */
+    template<
+        typename R,
+        typename D
+        //! \cond
+        , typename = typename std::enable_if< detail::conjunction<
+            std::is_constructible< data, typename detail::move_or_copy_construct_ref< R, resource_type >::type, typename detail::move_or_copy_construct_ref< D, deleter_type >::type >,
+            detail::disjunction< detail::negation< std::is_reference< resource_type > >, std::is_reference< R > > // prevent binding lvalue-reference resource to an rvalue
+        >::value >::type
+        //! \endcond
+    >
+    unique_resource(R&& res, D&& del, resource_site const& site)
         noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(
             std::is_nothrow_constructible<
                 data,
@@ -1278,6 +1503,7 @@ public:
             static_cast< typename detail::move_or_copy_construct_ref< D, deleter_type >::type >(del)
         )
     {
+        notify_acquire(site);
     }
 
     unique_resource(unique_resource const&) = delete;
@@ -1313,6 +1539,7 @@ public:
     unique_resource(unique_resource&& that) noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(std::is_nothrow_move_constructible< data >::value)) :
         m_data(static_cast< data&& >(that.m_data))
     {
+        notify_move(that);
     }
 
     /*!
@@ -1347,18 +1574,33 @@ public:
     {
         reset();
         m_data = static_cast< data&& >(that.m_data);
+        notify_move(that);
         return *this;
     }
 
     /*!
      * \brief If the resource is allocated, calls the deleter function on it. Destroys the resource and the deleter.
      *
+     * If fast teardown mode is enabled and the resource traits define a static constant \c skip_deleter_on_teardown
+     * with value \c true, the deleter is not called. See \c enable_fast_teardown.
+     *
      * **Throws:** Nothing, unless invoking the deleter throws.
      */
     ~unique_resource() noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_invocable< deleter_type&, resource_type& >::value))
     {
         if (BOOST_LIKELY(m_data.is_allocated()))
+        {
+            if (detail::is_skippable_on_teardown< traits_type >::value && BOOST_UNLIKELY(is_fast_teardown_enabled()))
+            {
+                if (instrumentation::enabled)
+                    instrumentation::type::on_release(this, m_data.get_resource());
+                return;
+            }
+
+            if (instrumentation::enabled)
+                instrumentation::type::on_reset(this, m_data.get_resource());
             m_data.get_deleter()(m_data.get_resource());
+        }
     }
 
     /*!
@@ -1412,6 +1654,8 @@ public:
      */
     void release() noexcept
     {
+        if (instrumentation::enabled && m_data.is_allocated())
+            instrumentation::type::on_release(this, m_data.get_resource());
         m_data.set_unallocated();
     }
 
@@ -1426,6 +1670,8 @@ public:
     {
         if (BOOST_LIKELY(m_data.is_allocated()))
         {
+            if (instrumentation::enabled)
+                instrumentation::type::on_reset(this, m_data.get_resource());
             m_data.get_deleter()(m_data.get_resource());
             m_data.set_unallocated();
         }
@@ -1445,11 +1691,15 @@ public:
      *
      * \param res Resource object to assign.
      *
+     * \note The overload does not participate in overload resolution if the resource traits define a static constant
+     *       \c deleter_bound_to_resource with value \c true. Use the overload that accepts a deleter instead.
+     *
      * \post `this->allocated() == false`
      */
     template< typename R >
 #if !defined(BOOST_SCOPE_DOXYGEN)
     typename std::enable_if< detail::conjunction<
+        detail::negation< detail::is_deleter_bound_to_resource< traits_type > >,
         std::is_assignable< internal_resource_type&, typename detail::move_or_copy_assign_ref< R, resource_type >::type >,
         detail::disjunction< detail::negation< std::is_reference< resource_type > >, std::is_reference< R > > // prevent binding lvalue-reference resource to an rvalue
     >::value >::type
@@ -1463,10 +1713,52 @@ public:
                 std::is_nothrow_assignable< internal_resource_type&, typename detail::move_or_copy_assign_ref< R, resource_type >::type >
             >::value
         ))
+    {
+        reset(static_cast< R&& >(res), resource_site());
+    }
+
+    /*!
+     * \brief Assigns a new resource object to the unique resource wrapper.
+     *
+     * **Effects:** Calls `this->reset()`. Then, if \c Resource is nothrow assignable from `R&&`,
+     *              assigns `std::forward< R >(res)` to the stored resource object, otherwise assigns
+     *              `res`.
+     *
+     *              If \a res is not an unallocated resource value and an exception is thrown during the operation,
+     *              invokes the stored deleter on \a res before returning with the exception.
+     *
+     * **Throws:** Nothing, unless invoking the deleter throws.
+     *
+     * \param res Resource object to assign.
+     * \param site Source location where the resource was acquired. Passed to the instrumentation.
+     *
+     * \note The overload does not participate in overload resolution if the resource traits define a static constant
+     *       \c deleter_bound_to_resource with value \c true. Use the overload that accepts a deleter instead.
+     *
+     * \post `this->allocated() == false`
+     */
+    template< typename R >
+#if !defined(BOOST_SCOPE_DOXYGEN)
+    typename std::enable_if< detail::conjunction<
+        detail::negation< detail::is_deleter_bound_to_resource< traits_type > >,
+        std::is_assignable< internal_resource_type&, typename detail::move_or_copy_assign_ref< R, resource_type >::type >,
+        detail::disjunction< detail::negation< std::is_reference< resource_type > >, std::is_reference< R > > // prevent binding lvalue-reference resource to an rvalue
+    >::value >::type
+#else
+    void
+#endif
+    reset(R&& res, resource_site const& site)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(
+            detail::conjunction<
+                detail::is_nothrow_invocable< deleter_type&, resource_type& >,
+                std::is_nothrow_assignable< internal_resource_type&, typename detail::move_or_copy_assign_ref< R, resource_type >::type >
+            >::value
+        ))
     {
         reset_impl
         (
             static_cast< R&& >(res),
+            site,
             typename detail::conjunction<
                 detail::is_nothrow_invocable< deleter_type&, resource_type& >,
                 std::is_nothrow_assignable< internal_resource_type&, typename detail::move_or_copy_assign_ref< R, resource_type >::type >
@@ -1474,6 +1766,80 @@ public:
         );
     }
 
+    /*!
+     * \brief Replaces the resource object and the deleter.
+     *
+     * **Effects:** Constructs a new unique resource wrapper as if by
+     *              `unique_resource(std::forward< R >(res), std::forward< D >(del))` and move-assigns it to `*this`.
+     *              As a result, the previously owned resource, if allocated, is freed with the previous deleter.
+     *
+     *              This overload should be used for resources, which require the deleter to be constructed
+     *              specifically for the resource object, such as buffers freed with sized deleters.
+     *
+     * **Throws:** Nothing, unless construction of \c Resource or \c Deleter or invoking the previous deleter throws.
+     *             If construction throws, the previously owned resource is not changed.
+     *
+     * \param res Resource object to assign.
+     * \param del Resource deleter function object.
+     */
+    template<
+        typename R,
+        typename D
+        //! \cond
+        , typename = typename std::enable_if< detail::conjunction<
+            detail::negation< std::is_same< typename std::decay< D >::type, resource_site > >,
+            std::is_constructible< unique_resource, R, D, resource_site const& >,
+            std::is_move_assignable< data >
+        >::value >::type
+        //! \endcond
+    >
+    void reset(R&& res, D&& del)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(
+            detail::conjunction<
+                std::is_nothrow_constructible< unique_resource, R, D, resource_site const& >,
+                std::is_nothrow_move_assignable< data >
+            >::value
+        ))
+    {
+        reset(static_cast< R&& >(res), static_cast< D&& >(del), resource_site());
+    }
+
+    /*!
+     * \brief Replaces the resource object and the deleter.
+     *
+     * **Effects:** Constructs a new unique resource wrapper as if by
+     *              `unique_resource(std::forward< R >(res), std::forward< D >(del), site)` and move-assigns it
+     *              to `*this`. As a result, the previously owned resource, if allocated, is freed with the previous
+     *              deleter.
+     *
+     * **Throws:** Nothing, unless construction of \c Resource or \c Deleter or invoking the previous deleter throws.
+     *             If construction throws, the previously owned resource is not changed.
+     *
+     * \param res Resource object to assign.
+     * \param del Resource deleter function object.
+     * \param site Source location where the resource was acquired. Passed to the instrumentation.
+     */
+    template<
+        typename R,
+        typename D
+        //! \cond
+        , typename = typename std::enable_if< detail::conjunction<
+            std::is_constructible< unique_resource, R, D, resource_site const& >,
+            std::is_move_assignable< data >
+        >::value >::type
+        //! \endcond
+    >
+    void reset(R&& res, D&& del, resource_site const& site)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(
+            detail::conjunction<
+                std::is_nothrow_constructible< unique_resource, R, D, resource_site const& >,
+                std::is_nothrow_move_assignable< data >
+            >::value
+        ))
+    {
+        *this = unique_resource(static_cast< R&& >(res), static_cast< D&& >(del), site);
+    }
+
     /*!
      * \brief Invokes indirection on the resource object.
      *
@@ -1546,6 +1912,8 @@ public:
         noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_swappable< data >::value))
     {
         m_data.swap(that.m_data);
+        if (instrumentation::enabled)
+            instrumentation::type::on_swap(this, boost::addressof(that));
     }
 
     /*!
@@ -1565,34 +1933,196 @@ public:
         left.swap(right);
     }
 
+    /*!
+     * \brief Compares resource objects for equality.
+     *
+     * **Requires:** \c Resource is equality comparable.
+     *
+     * **Effects:** Returns `left.get() == right.get()`.
+     *
+     * \note The resource objects are compared regardless of whether the unique resource wrappers
+     *       are in allocated state.
+     *
+     * **Throws:** Nothing, unless comparing the resource objects throws.
+     */
+#if !defined(BOOST_SCOPE_DOXYGEN)
+    template< bool Requires = detail::is_equality_comparable< resource_type >::value >
+    friend typename std::enable_if< Requires, bool >::type
+#else
+    friend bool
+#endif
+    operator== (unique_resource const& left, unique_resource const& right)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_equality_comparable< resource_type >::value))
+    {
+        return left.get() == right.get();
+    }
+
+    /*!
+     * \brief Compares resource objects for inequality.
+     *
+     * **Effects:** Returns `!(left == right)`.
+     */
+#if !defined(BOOST_SCOPE_DOXYGEN)
+    template< bool Requires = detail::is_equality_comparable< resource_type >::value >
+    friend typename std::enable_if< Requires, bool >::type
+#else
+    friend bool
+#endif
+    operator!= (unique_resource const& left, unique_resource const& right)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_equality_comparable< resource_type >::value))
+    {
+        return !(left.get() == right.get());
+    }
+
+    /*!
+     * \brief Compares resource objects for ordering.
+     *
+     * **Requires:** \c Resource is less-than comparable.
+     *
+     * **Effects:** Returns `left.get() < right.get()`.
+     *
+     * \note The resource objects are compared regardless of whether the unique resource wrappers
+     *       are in allocated state.
+     *
+     * **Throws:** Nothing, unless comparing the resource objects throws.
+     */
+#if !defined(BOOST_SCOPE_DOXYGEN)
+    template< bool Requires = detail::is_less_than_comparable< resource_type >::value >
+    friend typename std::enable_if< Requires, bool >::type
+#else
+    friend bool
+#endif
+    operator< (unique_resource const& left, unique_resource const& right)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_less_than_comparable< resource_type >::value))
+    {
+        return left.get() < right.get();
+    }
+
+    /*!
+     * \brief Compares resource objects for ordering.
+     *
+     * **Effects:** Returns `right < left`.
+     */
+#if !defined(BOOST_SCOPE_DOXYGEN)
+    template< bool Requires = detail::is_less_than_comparable< resource_type >::value >
+    friend typename std::enable_if< Requires, bool >::type
+#else
+    friend bool
+#endif
+    operator> (unique_resource const& left, unique_resource const& right)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_less_than_comparable< resource_type >::value))
+    {
+        return right.get() < left.get();
+    }
+
+    /*!
+     * \brief Compares resource objects for ordering.
+     *
+     * **Effects:** Returns `!(right < left)`.
+     */
+#if !defined(BOOST_SCOPE_DOXYGEN)
+    template< bool Requires = detail::is_less_than_comparable< resource_type >::value >
+    friend typename std::enable_if< Requires, bool >::type
+#else
+    friend bool
+#endif
+    operator<= (unique_resource const& left, unique_resource const& right)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_less_than_comparable< resource_type >::value))
+    {
+        return !(right.get() < left.get());
+    }
+
+    /*!
+     * \brief Compares resource objects for ordering.
+     *
+     * **Effects:** Returns `!(left < right)`.
+     */
+#if !defined(BOOST_SCOPE_DOXYGEN)
+    template< bool Requires = detail::is_less_than_comparable< resource_type >::value >
+    friend typename std::enable_if< Requires, bool >::type
+#else
+    friend bool
+#endif
+    operator>= (unique_resource const& left, unique_resource const& right)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::is_nothrow_less_than_comparable< resource_type >::value))
+    {
+        return !(left.get() < right.get());
+    }
+
+#if defined(BOOST_SCOPE_DETAIL_HAS_THREE_WAY_COMPARISON) || defined(BOOST_SCOPE_DOXYGEN)
+    /*!
+     * \brief Performs three-way comparison of resource objects.
+     *
+     * **Requires:** \c Resource is three-way comparable.
+     *
+     * **Effects:** Returns `left.get() <=> right.get()`.
+     *
+     * \note This operator is only available in C++20 and later.
+     *
+     * **Throws:** Nothing, unless comparing the resource objects throws.
+     */
+    friend auto operator<=> (unique_resource const& left, unique_resource const& right)
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(noexcept(std::compare_three_way()(left.get(), right.get()))))
+        requires std::three_way_comparable< resource_type >
+    {
+        return std::compare_three_way()(left.get(), right.get());
+    }
+#endif // defined(BOOST_SCOPE_DETAIL_HAS_THREE_WAY_COMPARISON) || defined(BOOST_SCOPE_DOXYGEN)
+
 //! \cond
 private:
     //! Assigns a new resource object to the unique resource wrapper.
     template< typename R >
-    void reset_impl(R&& res, std::true_type) noexcept
+    void reset_impl(R&& res, resource_site const& site, std::true_type) noexcept
     {
         reset();
         m_data.assign_resource(static_cast< typename detail::move_or_copy_assign_ref< R, resource_type >::type >(res));
+        notify_acquire(site);
     }
 
     //! Assigns a new resource object to the unique resource wrapper.
     template< typename R >
-    void reset_impl(R&& res, std::false_type)
+    void reset_impl(R&& res, resource_site const& site, std::false_type)
     {
-        try
+        BOOST_TRY
         {
             reset();
             m_data.assign_resource(static_cast< typename detail::move_or_copy_assign_ref< R, resource_type >::type >(res));
         }
-        catch (...)
+        BOOST_CATCH (...)
         {
             m_data.get_deleter()(static_cast< R&& >(res));
-            throw;
+            BOOST_RETHROW;
         }
+        BOOST_CATCH_END
+
+        notify_acquire(site);
+    }
+
+    //! Notifies instrumentation that the resource has been acquired
+    void notify_acquire(resource_site const& site) noexcept
+    {
+        if (instrumentation::enabled && m_data.is_allocated())
+            detail::resource_acquire_notifier< typename instrumentation::type >::notify(this, m_data.get_resource(), site);
+    }
+
+    //! Notifies instrumentation that the resource has been moved from another unique resource wrapper
+    void notify_move(unique_resource const& that) noexcept
+    {
+        if (instrumentation::enabled && m_data.is_allocated())
+            instrumentation::type::on_move(boost::addressof(that), this, m_data.get_resource());
     }
 //! \endcond
 };
 
+//! \cond
+template< typename Resource, typename Deleter, typename Traits >
+struct is_trivially_relocatable< unique_resource< Resource, Deleter, Traits > > :
+    public detail::is_unique_resource_trivially_relocatable< Resource, Deleter, Traits >::type
+{
+};
+//! \endcond
+
 #if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
 template<
     typename Resource,
@@ -1626,17 +2156,190 @@ make_unique_resource_checked(Resource&& res, Invalid const& invalid, Deleter&& d
             std::is_nothrow_constructible< typename std::decay< Deleter >::type, typename detail::move_or_copy_construct_ref< Deleter, typename std::decay< Deleter >::type >::type >
         >::value
     ))
+{
+    return boost::scope::make_unique_resource_checked(static_cast< Resource&& >(res), invalid, static_cast< Deleter&& >(del), resource_site());
+}
+
+/*!
+ * \brief Checks if the resource is valid and creates a \c unique_resource wrapper.
+ *
+ * **Effects:** If the resource \a res is not equal to \a invalid, creates a unique resource wrapper
+ *              that is in allocated state and owns \a res. Otherwise creates a unique resource wrapper
+ *              in unallocated state.
+ *
+ * \note This function does not call \a del if \a res is equal to \a invalid.
+ *
+ * **Throws:** Nothing, unless \c unique_resource constructor throws.
+ *
+ * \param res Resource to wrap.
+ * \param invalid An invalid value for the resource.
+ * \param del A deleter to invoke on the resource to free it.
+ * \param site Source location where the resource was acquired. Passed to the instrumentation.
+ */
+template< typename Resource, typename Deleter, typename Invalid >
+inline unique_resource< typename std::decay< Resource >::type, typename std::decay< Deleter >::type >
+make_unique_resource_checked(Resource&& res, Invalid const& invalid, Deleter&& del, resource_site const& site)
+    noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(
+        detail::conjunction<
+            std::is_nothrow_constructible< typename std::decay< Resource >::type, typename detail::move_or_copy_construct_ref< Resource, typename std::decay< Resource >::type >::type >,
+            std::is_nothrow_constructible< typename std::decay< Deleter >::type, typename detail::move_or_copy_construct_ref< Deleter, typename std::decay< Deleter >::type >::type >
+        >::value
+    ))
 {
     using unique_resource_type = unique_resource< typename std::decay< Resource >::type, typename std::decay< Deleter >::type >;
     if (!(res == invalid))
-        return unique_resource_type(static_cast< Resource&& >(res), static_cast< Deleter&& >(del));
+        return unique_resource_type(static_cast< Resource&& >(res), static_cast< Deleter&& >(del), site);
     else
         return unique_resource_type(default_resource_t(), static_cast< Deleter&& >(del));
 }
 
+//! \cond
+namespace detail {
+
+//! Returns the resource object owned by the unique resource wrapper
+template< typename Resource, typename Deleter, typename Traits >
+inline Resource const& get_resource_key(unique_resource< Resource, Deleter, Traits > const& res) noexcept
+{
+    return res.get();
+}
+
+//! Returns the resource object as is
+template< typename Resource >
+inline Resource const& get_resource_key(Resource const& res) noexcept
+{
+    return res;
+}
+
+//! Checks if \c std::hash is enabled for \c T
+template< typename T >
+struct is_hash_enabled :
+    public conjunction<
+        std::is_default_constructible< std::hash< T > >,
+        is_invocable< std::hash< T > const&, T const& >
+    >
+{
+};
+
+//! Implementation of \c std::hash specialization for \c unique_resource
+template< typename Resource, typename UniqueResource, bool = is_hash_enabled< Resource >::value >
+struct unique_resource_std_hash
+{
+    std::size_t operator() (UniqueResource const& res) const
+        noexcept(noexcept(std::hash< Resource >()(res.get())))
+    {
+        return std::hash< Resource >()(res.get());
+    }
+};
+
+//! Disabled \c std::hash specialization, for resource types that are not hashable
+template< typename Resource, typename UniqueResource >
+struct unique_resource_std_hash< Resource, UniqueResource, false >
+{
+    unique_resource_std_hash() = delete;
+    unique_resource_std_hash(unique_resource_std_hash const&) = delete;
+    unique_resource_std_hash& operator= (unique_resource_std_hash const&) = delete;
+};
+
+} // namespace detail
+//! \endcond
+
+/*!
+ * \brief Transparent hash function for \c unique_resource.
+ *
+ * The function object computes hash values of \c unique_resource objects and resource objects
+ * using \c std::hash on the resource objects, so that a \c unique_resource and the resource object
+ * it owns produce the same hash value. Together with \c unique_resource_equal, this allows to look up
+ * \c unique_resource objects in unordered associative containers by resource object, without
+ * constructing a \c unique_resource object. The function call operators only participate in overload
+ * resolution if \c std::hash is enabled for the resource type.
+ *
+ * ```
+ * std::unordered_set< boost::scope::unique_fd, boost::scope::unique_resource_hash, boost::scope::unique_resource_equal > fds;
+ * auto it = fds.find(fd); // fd is an int
+ * ```
+ *
+ * \note Heterogeneous lookup in unordered containers requires C++20. For the lookup to work correctly,
+ *       the type of the key must be the same as the resource type, as \c std::hash may produce different
+ *       values for objects of different types.
+ */
+struct unique_resource_hash
+{
+    //! Marks the function object as supporting heterogeneous lookup
+    using is_transparent = void;
+
+    //! Returns the hash value of the resource object owned by \a res
+    template<
+        typename Resource, typename Deleter, typename Traits
+        //! \cond
+        , typename = typename std::enable_if< detail::is_hash_enabled< Resource >::value >::type
+        //! \endcond
+    >
+    std::size_t operator() (unique_resource< Resource, Deleter, Traits > const& res) const
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(noexcept(std::hash< Resource >()(res.get()))))
+    {
+        return std::hash< Resource >()(res.get());
+    }
+
+    //! Returns the hash value of the resource object \a res
+    template<
+        typename Resource
+        //! \cond
+        , typename = typename std::enable_if< detail::is_hash_enabled< Resource >::value >::type
+        //! \endcond
+    >
+    std::size_t operator() (Resource const& res) const
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(noexcept(std::hash< Resource >()(res))))
+    {
+        return std::hash< Resource >()(res);
+    }
+};
+
+/*!
+ * \brief Transparent equality comparison function for \c unique_resource.
+ *
+ * The function object compares \c unique_resource objects and resource objects, in any combination,
+ * by comparing the resource objects for equality. See \c unique_resource_hash for an example of usage.
+ */
+struct unique_resource_equal
+{
+    //! Marks the function object as supporting heterogeneous lookup
+    using is_transparent = void;
+
+    //! Returns \c true if the resource objects are equal
+    template< typename T, typename U >
+    bool operator() (T const& left, U const& right) const
+        noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(noexcept(detail::get_resource_key(left) == detail::get_resource_key(right))))
+    {
+        return detail::get_resource_key(left) == detail::get_resource_key(right);
+    }
+};
+
 } // namespace scope
 } // namespace boost
 
+namespace std {
+
+/*!
+ * \brief Hash function for \c unique_resource.
+ *
+ * The hash value of a \c unique_resource object is equal to the hash value of the resource object it owns,
+ * as computed by \c std::hash. The specialization is disabled if \c std::hash is not enabled for
+ * the resource type.
+ */
+template< typename Resource, typename Deleter, typename Traits >
+struct hash< boost::scope::unique_resource< Resource, Deleter, Traits > >
+    //! \cond
+    : public boost::scope::detail::unique_resource_std_hash< Resource, boost::scope::unique_resource< Resource, Deleter, Traits > >
+    //! \endcond
+{
+#if defined(BOOST_SCOPE_DOXYGEN)
+    //! Returns the hash value of the resource object owned by \a res
+    std::size_t operator() (boost::scope::unique_resource< Resource, Deleter, Traits > const& res) const;
+#endif
+};
+
+} // namespace std
+
 #include <boost/scope/detail/footer.hpp>
 
 #endif // BOOST_SCOPE_UNIQUE_RESOURCE_HPP_INCLUDED_
@@ -15,6 +15,7 @@
 #define BOOST_SCOPE_UNIQUE_RESOURCE_FWD_HPP_INCLUDED_
 
 #include <type_traits>
+#include <boost/scope/resource_site.hpp>
 #include <boost/scope/detail/config.hpp>
 #include <boost/scope/detail/move_or_copy_construct_ref.hpp>
 #include <boost/scope/detail/type_traits/conjunction.hpp>
@@ -38,6 +39,14 @@ make_unique_resource_checked(Resource&& res, Invalid const& invalid, Deleter&& d
         std::is_nothrow_constructible< typename std::decay< Deleter >::type, typename detail::move_or_copy_construct_ref< Deleter, typename std::decay< Deleter >::type >::type >
     >::value));
 
+template< typename Resource, typename Deleter, typename Invalid = typename std::decay< Resource >::type >
+unique_resource< typename std::decay< Resource >::type, typename std::decay< Deleter >::type >
+make_unique_resource_checked(Resource&& res, Invalid const& invalid, Deleter&& del, resource_site const& site)
+    noexcept(BOOST_SCOPE_DETAIL_DOC_HIDDEN(detail::conjunction<
+        std::is_nothrow_constructible< typename std::decay< Resource >::type, typename detail::move_or_copy_construct_ref< Resource, typename std::decay< Resource >::type >::type >,
+        std::is_nothrow_constructible< typename std::decay< Deleter >::type, typename detail::move_or_copy_construct_ref< Deleter, typename std::decay< Deleter >::type >::type >
+    >::value));
+
 } // namespace scope
 } // namespace boost
 
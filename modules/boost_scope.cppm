@@ -0,0 +1,217 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   boost_scope.cppm
+ *
+ * This file contains the C++20 module interface unit of Boost.Scope.
+ *
+ * The module is named `boost.scope` and exports all public components of
+ * the library. Macros, such as \c BOOST_SCOPE_DEFER, cannot be exported
+ * from modules; users should include `boost/scope/defer_macro.hpp` for them.
+ */
+
+module;
+
+#include <boost/scope/action_list.hpp>
+#include <boost/scope/arena_scope.hpp>
+#include <boost/scope/defer.hpp>
+#include <boost/scope/error_code_checker.hpp>
+#include <boost/scope/errno_checker.hpp>
+#include <boost/scope/exception_checker.hpp>
+#include <boost/scope/failure_scope.hpp>
+#include <boost/scope/fast_teardown.hpp>
+#include <boost/scope/fd_deleter.hpp>
+#include <boost/scope/fd_factories.hpp>
+#include <boost/scope/fd_passing.hpp>
+#include <boost/scope/fd_resource_traits.hpp>
+#include <boost/scope/fd_table.hpp>
+#include <boost/scope/is_trivially_relocatable.hpp>
+#include <boost/scope/latency_histogram.hpp>
+#include <boost/scope/madvise_scope.hpp>
+#include <boost/scope/perf_counter_scope.hpp>
+#include <boost/scope/resource_leak_detector.hpp>
+#include <boost/scope/resource_site.hpp>
+#include <boost/scope/resource_usage_counters.hpp>
+#include <boost/scope/result_checker.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/scope_fail.hpp>
+#include <boost/scope/scope_success.hpp>
+#include <boost/scope/sized_deleter.hpp>
+#include <boost/scope/timed_deleter.hpp>
+#include <boost/scope/trace_scope.hpp>
+#include <boost/scope/thread_scope_exit.hpp>
+#include <boost/scope/transaction_scope.hpp>
+#include <boost/scope/tsc_clock.hpp>
+#include <boost/scope/unique_buffer.hpp>
+#include <boost/scope/unique_dirfd.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/unique_memfd_buffer.hpp>
+#include <boost/scope/unique_resource.hpp>
+
+export module boost.scope;
+
+export namespace boost::scope {
+
+// scope_exit.hpp
+using boost::scope::always_true;
+using boost::scope::scope_exit;
+using boost::scope::make_scope_exit;
+
+// scope_fail.hpp
+using boost::scope::scope_fail;
+using boost::scope::make_scope_fail;
+
+// scope_success.hpp
+using boost::scope::scope_success;
+using boost::scope::make_scope_success;
+
+// action_list.hpp
+using boost::scope::action_list;
+using boost::scope::make_action_list;
+
+// defer.hpp
+using boost::scope::defer_guard;
+
+// exception_checker.hpp
+using boost::scope::exception_checker;
+using boost::scope::check_exception;
+
+// error_code_checker.hpp
+using boost::scope::error_code_checker;
+using boost::scope::check_error_code;
+
+// result_checker.hpp
+using boost::scope::result_checker;
+using boost::scope::check_result;
+
+// errno_checker.hpp
+using boost::scope::errno_checker;
+using boost::scope::check_errno;
+
+// failure_scope.hpp
+using boost::scope::failure_scope;
+using boost::scope::shared_exception_checker;
+
+// is_trivially_relocatable.hpp
+using boost::scope::is_trivially_relocatable;
+
+// unique_resource.hpp
+using boost::scope::unique_resource;
+using boost::scope::make_unique_resource_checked;
+using boost::scope::default_resource_t;
+using boost::scope::default_resource;
+using boost::scope::unallocated_resource;
+using boost::scope::unique_resource_hash;
+using boost::scope::unique_resource_equal;
+
+// fast_teardown.hpp
+using boost::scope::enable_fast_teardown;
+using boost::scope::is_fast_teardown_enabled;
+
+// resource_usage_counters.hpp
+using boost::scope::resource_event;
+using boost::scope::resource_usage_snapshot;
+using boost::scope::resource_usage_counters;
+
+// resource_site.hpp, resource_leak_detector.hpp
+using boost::scope::resource_site;
+using boost::scope::resource_leak_record;
+using boost::scope::resource_leak_detector;
+
+// latency_histogram.hpp, timed_deleter.hpp, tsc_clock.hpp
+using boost::scope::latency_histogram;
+using boost::scope::timed_deleter;
+using boost::scope::tsc_clock;
+
+// transaction_scope.hpp
+using boost::scope::transaction_scope;
+
+// arena_scope.hpp
+using boost::scope::arena_traits;
+using boost::scope::arena_scope;
+using boost::scope::arena_deleter;
+
+// madvise_scope.hpp
+#if !defined(BOOST_WINDOWS)
+using boost::scope::madvise_hints;
+using boost::scope::madvise_scope;
+#endif
+
+// perf_counter_scope.hpp
+#if defined(__linux__)
+using boost::scope::perf_counter_source;
+using boost::scope::perf_counter_values;
+using boost::scope::perf_counter_scope;
+using boost::scope::this_thread_perf_counters;
+using boost::scope::this_thread_perf_counter_source;
+#endif
+
+// thread_scope_exit.hpp
+using boost::scope::thread_scope_exit;
+
+// trace_scope.hpp
+using boost::scope::trace_event;
+using boost::scope::trace_record;
+using boost::scope::trace_scope;
+using boost::scope::drain_trace_records;
+
+// fd_deleter.hpp, fd_resource_traits.hpp, unique_fd.hpp
+using boost::scope::fd_deleter;
+using boost::scope::fd_resource_traits;
+using boost::scope::unique_fd;
+
+// fd_factories.hpp
+#if !defined(BOOST_WINDOWS)
+using boost::scope::open_fd;
+using boost::scope::socket_fd;
+using boost::scope::accept_fd;
+using boost::scope::pipe_fds;
+using boost::scope::dup_fd;
+#if defined(__linux__)
+using boost::scope::eventfd_fd;
+using boost::scope::memfd_fd;
+#endif
+#endif
+
+// fd_passing.hpp
+#if !defined(BOOST_WINDOWS)
+using boost::scope::max_fds_per_message;
+using boost::scope::send_fds;
+using boost::scope::recv_fds;
+#endif
+
+// unique_dirfd.hpp
+#if !defined(BOOST_WINDOWS)
+using boost::scope::unique_dirfd;
+using boost::scope::open_dir;
+using boost::scope::open_dir_at;
+using boost::scope::open_at;
+using boost::scope::stat_at;
+using boost::scope::unlink_at;
+using boost::scope::rename_at;
+using boost::scope::mkdir_at;
+#endif
+
+// unique_memfd_buffer.hpp
+#if defined(__linux__)
+using boost::scope::memfd_buffer_options;
+using boost::scope::unique_memfd_buffer;
+#endif
+
+// fd_table.hpp
+using boost::scope::fd_table;
+
+// sized_deleter.hpp, unique_buffer.hpp
+using boost::scope::sized_deleter;
+using boost::scope::sized_free_deleter;
+using boost::scope::buffer_resource_traits;
+using boost::scope::unique_buffer;
+using boost::scope::unique_malloc_buffer;
+using boost::scope::make_unique_buffer;
+
+} // namespace boost::scope
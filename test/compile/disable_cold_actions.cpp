@@ -0,0 +1,80 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   disable_cold_actions.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file tests that scope guards with failure conditions compile
+ *         when \c BOOST_SCOPE_DISABLE_COLD_ACTIONS is defined.
+ */
+
+#define BOOST_SCOPE_DISABLE_COLD_ACTIONS
+
+#include <boost/config.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/scope_fail.hpp>
+#include <boost/scope/exception_checker.hpp>
+#include <boost/scope/error_code_checker.hpp>
+#include <boost/scope/result_checker.hpp>
+#include <boost/scope/errno_checker.hpp>
+#include <boost/scope/failure_scope.hpp>
+#include <system_error>
+
+struct count_func
+{
+    int* m_n;
+
+    explicit count_func(int& n) noexcept : m_n(&n) {}
+
+    void operator()() const noexcept
+    {
+        ++(*m_n);
+    }
+};
+
+// A minimal \c std::expected-like result type
+struct test_result
+{
+    bool m_has_value;
+
+    bool has_value() const noexcept
+    {
+        return m_has_value;
+    }
+};
+
+template< typename Cond >
+void check_condition(count_func const& func, Cond const& cond)
+{
+    static_assert(boost::scope::detail::is_failure_condition< Cond >::value, "The condition must be a failure condition");
+    static_assert(!boost::scope::detail::is_cold_action_condition< Cond >::value, "Cold actions must be disabled");
+
+    boost::scope::scope_exit< count_func, Cond > exit_guard(func, cond);
+    boost::scope::scope_fail< count_func, Cond > fail_guard(func, cond);
+}
+
+int main()
+{
+    int n = 0;
+    count_func func(n);
+
+    check_condition(func, boost::scope::check_exception());
+
+    std::error_code ec;
+    check_condition(func, boost::scope::check_error_code(ec));
+
+    test_result res = { true };
+    check_condition(func, boost::scope::check_result(res));
+
+    check_condition(func, boost::scope::check_errno());
+
+    boost::scope::failure_scope fs;
+    check_condition(func, fs.checker());
+
+    return n;
+}
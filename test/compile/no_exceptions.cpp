@@ -0,0 +1,130 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   no_exceptions.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file tests that the library can be used with exceptions disabled.
+ *
+ * The test is intended to be compiled with exceptions disabled (e.g. with -fno-exceptions),
+ * but must also compile when exceptions are enabled.
+ */
+
+#include <boost/config.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/scope_fail.hpp>
+#include <boost/scope/scope_success.hpp>
+#include <boost/scope/defer.hpp>
+#include <boost/scope/exception_checker.hpp>
+#include <boost/scope/failure_scope.hpp>
+#include <boost/scope/unique_resource.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/resource_leak_detector.hpp>
+#include <type_traits>
+
+#if defined(BOOST_NO_EXCEPTIONS)
+static_assert(std::is_empty< boost::scope::exception_checker >::value, "exception_checker must be empty when exceptions are disabled");
+#endif
+
+// Function object with a potentially throwing copy constructor, which makes scope guards and unique_resource use
+// code paths that handle exceptions when exceptions are enabled
+struct potentially_throwing_func
+{
+    int* m_n;
+
+    explicit potentially_throwing_func(int& n) noexcept : m_n(&n) {}
+    potentially_throwing_func(potentially_throwing_func const& that) noexcept(false) : m_n(that.m_n) {}
+
+    void operator()() const noexcept
+    {
+        ++(*m_n);
+    }
+
+    void operator()(int res) const noexcept
+    {
+        *m_n += res;
+    }
+};
+
+struct potentially_throwing_resource
+{
+    int value;
+
+    potentially_throwing_resource() noexcept : value(0) {}
+    explicit potentially_throwing_resource(int v) noexcept : value(v) {}
+    potentially_throwing_resource(potentially_throwing_resource const& that) noexcept(false) : value(that.value) {}
+    potentially_throwing_resource& operator= (potentially_throwing_resource const& that) noexcept(false)
+    {
+        value = that.value;
+        return *this;
+    }
+};
+
+struct resource_deleter
+{
+    int* m_n;
+
+    explicit resource_deleter(int& n) noexcept : m_n(&n) {}
+    resource_deleter(resource_deleter const& that) noexcept(false) : m_n(that.m_n) {}
+
+    void operator()(potentially_throwing_resource const& res) const noexcept
+    {
+        *m_n += res.value;
+    }
+};
+
+struct leak_detector_traits
+{
+    using instrumentation = boost::scope::resource_leak_detector< leak_detector_traits >;
+
+    static int make_default() noexcept
+    {
+        return -1;
+    }
+
+    static bool is_allocated(int res) noexcept
+    {
+        return res >= 0;
+    }
+};
+
+int main()
+{
+    int n = 0;
+    potentially_throwing_func func(n);
+    {
+        boost::scope::scope_exit< potentially_throwing_func > guard(func);
+        boost::scope::scope_fail< potentially_throwing_func > fail_guard(func);
+        boost::scope::scope_success< potentially_throwing_func > success_guard(func);
+        boost::scope::defer_guard< potentially_throwing_func > defer(func);
+    }
+
+    {
+        boost::scope::failure_scope fs;
+        boost::scope::scope_fail< potentially_throwing_func, boost::scope::shared_exception_checker > fail_guard(func, fs.checker());
+    }
+
+    {
+        potentially_throwing_resource res(10);
+        resource_deleter del(n);
+        boost::scope::unique_resource< potentially_throwing_resource, resource_deleter > ur1(res, del);
+        boost::scope::unique_resource< potentially_throwing_resource, resource_deleter > ur2(std::move(ur1));
+        ur2.reset(res);
+    }
+
+    {
+        boost::scope::unique_resource< int, potentially_throwing_func, leak_detector_traits > ur(1, func);
+        ur.reset(2);
+    }
+
+    {
+        boost::scope::unique_fd fd;
+    }
+
+    return n > 0 ? 0 : 1;
+}
@@ -0,0 +1,47 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   usage.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for using Boost.Scope through the \c boost.scope C++20 module.
+ */
+
+import boost.scope;
+
+#include <boost/scope/defer_macro.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+int main()
+{
+    int n = 0;
+    {
+        boost::scope::scope_exit guard{ [&n] { ++n; } };
+        BOOST_TEST(guard.active());
+    }
+    BOOST_TEST_EQ(n, 1);
+
+    n = 0;
+    {
+        BOOST_SCOPE_DEFER [&n] { ++n; };
+    }
+    BOOST_TEST_EQ(n, 1);
+
+    n = 0;
+    {
+        boost::scope::scope_fail guard{ [&n] { ++n; } };
+    }
+    BOOST_TEST_EQ(n, 0);
+
+    {
+        boost::scope::unique_fd fd;
+        BOOST_TEST(!fd.allocated());
+    }
+
+    return boost::report_errors();
+}
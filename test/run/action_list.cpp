@@ -0,0 +1,191 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   action_list.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c action_list.
+ */
+
+#include <boost/scope/action_list.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/scope_fail.hpp>
+#include <boost/scope/scope_success.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include "function_types.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+// warning C4702: unreachable code
+#pragma warning(disable: 4702)
+#endif
+
+struct log_func
+{
+    std::vector< int >* m_log;
+    int m_id;
+
+    log_func(std::vector< int >& log, int id) noexcept :
+        m_log(&log),
+        m_id(id)
+    {
+    }
+
+    void operator()() const
+    {
+        m_log->push_back(m_id);
+    }
+};
+
+struct empty_func1
+{
+    void operator()() const noexcept {}
+};
+
+struct empty_func2
+{
+    void operator()() const noexcept {}
+};
+
+static int g_n = 0;
+
+void increment_n() noexcept
+{
+    ++g_n;
+}
+
+void check_order()
+{
+    std::vector< int > log;
+    {
+        boost::scope::scope_exit< boost::scope::action_list< log_func, log_func, log_func > > guard
+        {
+            boost::scope::action_list< log_func, log_func, log_func >(log_func(log, 1), log_func(log, 2), log_func(log, 3))
+        };
+    }
+    BOOST_TEST_EQ(log.size(), 3u);
+    if (log.size() == 3u)
+    {
+        BOOST_TEST_EQ(log[0], 3);
+        BOOST_TEST_EQ(log[1], 2);
+        BOOST_TEST_EQ(log[2], 1);
+    }
+}
+
+void check_activation()
+{
+    int n = 0, m = 0;
+    {
+        auto guard = boost::scope::make_scope_exit(boost::scope::make_action_list(normal_func(n), normal_func(m), increment_n));
+        BOOST_TEST(guard.active());
+        guard.set_active(false);
+    }
+    BOOST_TEST_EQ(n, 0);
+    BOOST_TEST_EQ(m, 0);
+    BOOST_TEST_EQ(g_n, 0);
+
+    {
+        auto guard = boost::scope::make_scope_exit(boost::scope::make_action_list(normal_func(n), normal_func(m), increment_n), false);
+        guard.set_active(true);
+    }
+    BOOST_TEST_EQ(n, 1);
+    BOOST_TEST_EQ(m, 1);
+    BOOST_TEST_EQ(g_n, 1);
+    g_n = 0;
+
+    n = 0;
+    m = 0;
+    {
+        auto guard1 = boost::scope::make_scope_exit(boost::scope::make_action_list(moveable_only_func(n), normal_func(m)));
+        auto guard2 = std::move(guard1);
+        BOOST_TEST(!guard1.active());
+        BOOST_TEST(guard2.active());
+    }
+    BOOST_TEST_EQ(n, 1);
+    BOOST_TEST_EQ(m, 1);
+}
+
+void check_cond()
+{
+    int n = 0, m = 0;
+    try
+    {
+        boost::scope::scope_fail< boost::scope::action_list< normal_func, normal_func > > guard
+        {
+            boost::scope::make_action_list(normal_func(n), normal_func(m))
+        };
+        throw std::runtime_error("error");
+    }
+    catch (...) {}
+    BOOST_TEST_EQ(n, 1);
+    BOOST_TEST_EQ(m, 1);
+
+    n = 0;
+    m = 0;
+    {
+        boost::scope::scope_fail< boost::scope::action_list< normal_func, normal_func > > guard
+        {
+            boost::scope::make_action_list(normal_func(n), normal_func(m))
+        };
+    }
+    BOOST_TEST_EQ(n, 0);
+    BOOST_TEST_EQ(m, 0);
+
+    {
+        boost::scope::scope_success< boost::scope::action_list< normal_func, normal_func > > guard
+        {
+            boost::scope::make_action_list(normal_func(n), normal_func(m))
+        };
+    }
+    BOOST_TEST_EQ(n, 1);
+    BOOST_TEST_EQ(m, 1);
+}
+
+void check_traits()
+{
+    using empty_list = boost::scope::action_list< empty_func1, empty_func2 >;
+    BOOST_TEST_EQ(sizeof(empty_list), 1u);
+    BOOST_TEST_EQ(sizeof(boost::scope::action_list< normal_func, normal_func >), sizeof(normal_func) * 2u);
+    BOOST_TEST_EQ(sizeof(boost::scope::action_list< normal_func, empty_func1, normal_func >), sizeof(normal_func) * 2u);
+    // A single scope guard is smaller than multiple scope guards for the same actions
+    BOOST_TEST_LT(sizeof(boost::scope::scope_exit< boost::scope::action_list< normal_func, normal_func > >),
+        sizeof(boost::scope::scope_exit< normal_func >) * 2u);
+
+    BOOST_TEST((noexcept(std::declval< empty_list& >()())));
+    BOOST_TEST((!noexcept(std::declval< boost::scope::action_list< empty_func1, log_func >& >()())));
+    BOOST_TEST((boost::scope::is_trivially_relocatable< boost::scope::action_list< normal_func, empty_func1 > >::value));
+}
+
+void check_deduction()
+{
+#if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
+    int n = 0, m = 0;
+    {
+        boost::scope::scope_exit guard{ boost::scope::action_list{ normal_func(n), normal_func(m) } };
+        BOOST_TEST_TRAIT_SAME(decltype(guard), boost::scope::scope_exit< boost::scope::action_list< normal_func, normal_func > >);
+    }
+    BOOST_TEST_EQ(n, 1);
+    BOOST_TEST_EQ(m, 1);
+#endif
+}
+
+int main()
+{
+    check_order();
+    check_activation();
+    check_cond();
+    check_traits();
+    check_deduction();
+
+    return boost::report_errors();
+}
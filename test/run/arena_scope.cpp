@@ -0,0 +1,202 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   arena_scope.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c arena_scope and \c arena_deleter.
+ */
+
+#include <boost/scope/arena_scope.hpp>
+#include <boost/scope/unique_resource.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+// warning C4702: unreachable code
+#pragma warning(disable: 4702)
+#endif
+
+class bump_arena
+{
+private:
+    alignas(std::max_align_t) unsigned char m_storage[1024];
+    std::size_t m_used;
+
+public:
+    bump_arena() noexcept : m_used(0u) {}
+
+    void* allocate(std::size_t size)
+    {
+        size = (size + (alignof(std::max_align_t) - 1u)) & ~(alignof(std::max_align_t) - 1u);
+        if (size > sizeof(m_storage) - m_used)
+            throw std::bad_alloc();
+        void* p = m_storage + m_used;
+        m_used += size;
+        return p;
+    }
+
+    std::size_t used() const noexcept { return m_used; }
+
+    std::size_t mark() const noexcept { return m_used; }
+    void rewind(std::size_t marker) noexcept { m_used = marker; }
+};
+
+// Arena with a different interface, adapted with arena_traits
+struct legacy_arena
+{
+    unsigned int top = 0u;
+};
+
+namespace boost {
+namespace scope {
+
+template< >
+struct arena_traits< legacy_arena >
+{
+    using marker_type = unsigned int;
+
+    static marker_type mark(legacy_arena& arena) noexcept
+    {
+        return arena.top;
+    }
+
+    static void rewind(legacy_arena& arena, marker_type marker) noexcept
+    {
+        arena.top = marker;
+    }
+};
+
+} // namespace scope
+} // namespace boost
+
+void check_rewind()
+{
+    bump_arena arena;
+    arena.allocate(16u);
+    const std::size_t initial = arena.used();
+    {
+        boost::scope::arena_scope< bump_arena > guard(arena);
+        BOOST_TEST(guard.active());
+        arena.allocate(100u);
+        arena.allocate(200u);
+        BOOST_TEST_GT(arena.used(), initial);
+    }
+    BOOST_TEST_EQ(arena.used(), initial);
+
+    // Nested scopes
+    {
+        boost::scope::arena_scope< bump_arena > outer(arena);
+        arena.allocate(32u);
+        const std::size_t middle = arena.used();
+        {
+            boost::scope::arena_scope< bump_arena > inner(arena);
+            arena.allocate(64u);
+        }
+        BOOST_TEST_EQ(arena.used(), middle);
+    }
+    BOOST_TEST_EQ(arena.used(), initial);
+
+    // Inactive guard does not rewind
+    {
+        boost::scope::arena_scope< bump_arena > guard(arena);
+        arena.allocate(32u);
+        guard.set_active(false);
+    }
+    BOOST_TEST_GT(arena.used(), initial);
+}
+
+void check_exception()
+{
+    bump_arena arena;
+    try
+    {
+        boost::scope::arena_scope< bump_arena > guard(arena);
+        while (true)
+            arena.allocate(100u);
+    }
+    catch (std::bad_alloc&)
+    {
+    }
+    BOOST_TEST_EQ(arena.used(), 0u);
+}
+
+void check_move()
+{
+    bump_arena arena;
+    {
+        boost::scope::arena_scope< bump_arena > guard1(arena);
+        arena.allocate(16u);
+        {
+            boost::scope::arena_scope< bump_arena > guard2(std::move(guard1));
+            BOOST_TEST(!guard1.active());
+            BOOST_TEST(guard2.active());
+        }
+        BOOST_TEST_EQ(arena.used(), 0u);
+        arena.allocate(16u);
+    }
+    BOOST_TEST_EQ(arena.used(), 16u);
+}
+
+void check_traits()
+{
+    legacy_arena arena;
+    arena.top = 10u;
+    {
+        boost::scope::arena_scope< legacy_arena > guard(arena);
+        arena.top = 20u;
+    }
+    BOOST_TEST_EQ(arena.top, 10u);
+
+    BOOST_TEST((boost::scope::is_trivially_relocatable< boost::scope::arena_scope< legacy_arena > >::value));
+
+#if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
+    {
+        boost::scope::arena_scope guard(arena);
+        BOOST_TEST((std::is_same< decltype(guard), boost::scope::arena_scope< legacy_arena > >::value));
+    }
+#endif
+}
+
+struct point
+{
+    int x, y;
+};
+
+void check_deleter()
+{
+    bump_arena arena;
+    {
+        boost::scope::arena_scope< bump_arena > guard(arena);
+        boost::scope::unique_resource< point*, boost::scope::arena_deleter > p(new (arena.allocate(sizeof(point))) point{ 1, 2 }, boost::scope::arena_deleter());
+        BOOST_TEST_EQ(p->x, 1);
+        BOOST_TEST_EQ(p->y, 2);
+        BOOST_TEST_GT(arena.used(), 0u);
+        p.reset();
+        // The memory is not freed until the arena is rewound
+        BOOST_TEST_GT(arena.used(), 0u);
+    }
+    BOOST_TEST_EQ(arena.used(), 0u);
+
+    BOOST_TEST(std::is_empty< boost::scope::arena_deleter >::value);
+}
+
+int main()
+{
+    check_rewind();
+    check_exception();
+    check_move();
+    check_traits();
+    check_deleter();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,143 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   compact_layout.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for the size of scope guards and unique resource wrappers with empty function objects.
+ */
+
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/scope_fail.hpp>
+#include <boost/scope/scope_success.hpp>
+#include <boost/scope/defer.hpp>
+#include <boost/scope/unique_resource.hpp>
+#include <boost/scope/detail/config.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+
+struct empty_action
+{
+    void operator() () const noexcept
+    {
+    }
+};
+
+struct final_empty_action final
+{
+    void operator() () const noexcept
+    {
+    }
+};
+
+struct empty_cond
+{
+    bool operator() () const noexcept
+    {
+        return true;
+    }
+};
+
+struct final_empty_cond final
+{
+    bool operator() () const noexcept
+    {
+        return true;
+    }
+};
+
+struct empty_deleter
+{
+    void operator() (int) const noexcept
+    {
+    }
+};
+
+struct final_empty_deleter final
+{
+    void operator() (int) const noexcept
+    {
+    }
+};
+
+struct int_traits
+{
+    static int make_default() noexcept
+    {
+        return -1;
+    }
+
+    static bool is_allocated(int res) noexcept
+    {
+        return res >= 0;
+    }
+};
+
+// Checks whether the compiler supports [[no_unique_address]] for final classes
+struct no_unique_address_probe
+{
+    BOOST_SCOPE_DETAIL_NO_UNIQUE_ADDRESS final_empty_deleter del;
+    int value;
+};
+
+BOOST_CONSTEXPR_OR_CONST bool has_no_unique_address = sizeof(no_unique_address_probe) == sizeof(int);
+
+void check_scope_guards()
+{
+    // Empty function objects should not add to the size of the active flag
+    BOOST_TEST_EQ(sizeof(boost::scope::scope_exit< empty_action >), sizeof(bool));
+    BOOST_TEST_EQ(sizeof(boost::scope::scope_exit< empty_action, empty_cond >), sizeof(bool));
+    BOOST_TEST_EQ(sizeof(boost::scope::scope_fail< empty_action, empty_cond >), sizeof(bool));
+    BOOST_TEST_EQ(sizeof(boost::scope::scope_success< empty_action, empty_cond >), sizeof(bool));
+    BOOST_TEST_EQ(sizeof(boost::scope::defer_guard< empty_action >), 1u);
+    BOOST_TEST_EQ(sizeof(boost::scope::defer_guard< final_empty_action >), 1u);
+
+    // Non-empty function objects
+    BOOST_TEST_EQ(sizeof(boost::scope::scope_exit< void (*)() >), 2u * sizeof(void (*)()));
+    BOOST_TEST_EQ(sizeof(boost::scope::scope_exit< empty_action& >), 2u * sizeof(void*));
+
+    if (has_no_unique_address)
+    {
+        BOOST_TEST_EQ(sizeof(boost::scope::scope_exit< final_empty_action >), sizeof(bool));
+        BOOST_TEST_EQ(sizeof(boost::scope::scope_exit< final_empty_action, final_empty_cond >), sizeof(bool));
+        BOOST_TEST_EQ(sizeof(boost::scope::scope_exit< empty_action, final_empty_cond >), sizeof(bool));
+        BOOST_TEST_EQ(sizeof(boost::scope::scope_fail< final_empty_action, final_empty_cond >), sizeof(bool));
+        BOOST_TEST_EQ(sizeof(boost::scope::scope_success< final_empty_action, final_empty_cond >), sizeof(bool));
+    }
+    else
+    {
+        BOOST_TEST_LE(sizeof(boost::scope::scope_exit< final_empty_action, final_empty_cond >), 3u);
+    }
+}
+
+void check_unique_resource()
+{
+    // Resource traits allow to avoid storing the allocated flag
+    BOOST_TEST_EQ((sizeof(boost::scope::unique_resource< int, empty_deleter, int_traits >)), sizeof(int));
+    BOOST_TEST_EQ((sizeof(boost::scope::unique_resource< int, empty_deleter >)), 2u * sizeof(int));
+    BOOST_TEST_EQ((sizeof(boost::scope::unique_resource< int, void (*)(int) >)), 3u * sizeof(void (*)(int)));
+
+    if (has_no_unique_address)
+    {
+        BOOST_TEST_EQ((sizeof(boost::scope::unique_resource< int, final_empty_deleter, int_traits >)), sizeof(int));
+        BOOST_TEST_EQ((sizeof(boost::scope::unique_resource< int, final_empty_deleter >)), 2u * sizeof(int));
+    }
+    else
+    {
+        BOOST_TEST_EQ((sizeof(boost::scope::unique_resource< int, final_empty_deleter, int_traits >)), 2u * sizeof(int));
+        BOOST_TEST_EQ((sizeof(boost::scope::unique_resource< int, final_empty_deleter >)), 2u * sizeof(int));
+    }
+}
+
+int main()
+{
+    check_scope_guards();
+    check_unique_resource();
+
+    return boost::report_errors();
+}
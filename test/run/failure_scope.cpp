@@ -0,0 +1,114 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   failure_scope.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c failure_scope.
+ */
+
+#include <boost/scope/failure_scope.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/scope_fail.hpp>
+#include <boost/scope/scope_success.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <stdexcept>
+#include "function_types.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+// warning C4702: unreachable code
+#pragma warning(disable: 4702)
+#endif
+
+struct nested_guards
+{
+    int* m_failed;
+    int* m_succeeded;
+
+    nested_guards(int& failed, int& succeeded) noexcept :
+        m_failed(&failed),
+        m_succeeded(&succeeded)
+    {
+    }
+
+    void operator()() const noexcept
+    {
+        boost::scope::failure_scope fs;
+        boost::scope::scope_fail< normal_func, boost::scope::shared_exception_checker > guard1(normal_func(*m_failed), fs.checker());
+        boost::scope::scope_success< normal_func, boost::scope::shared_exception_checker > guard2(normal_func(*m_succeeded), fs.checker());
+    }
+};
+
+void check_normal()
+{
+    int failed = 0, succeeded = 0;
+    {
+        boost::scope::failure_scope fs;
+        BOOST_TEST(!fs.failed());
+
+        boost::scope::scope_fail< normal_func, boost::scope::shared_exception_checker > guard1(normal_func(failed), fs.checker());
+        boost::scope::scope_fail< normal_func, boost::scope::shared_exception_checker > guard2(normal_func(failed), fs.checker());
+        boost::scope::scope_success< normal_func, boost::scope::shared_exception_checker > guard3(normal_func(succeeded), fs.checker());
+        boost::scope::scope_success< normal_func, boost::scope::shared_exception_checker > guard4(normal_func(succeeded), fs.checker());
+    }
+    BOOST_TEST_EQ(failed, 0);
+    BOOST_TEST_EQ(succeeded, 2);
+}
+
+void check_throw()
+{
+    int failed = 0, succeeded = 0;
+    try
+    {
+        boost::scope::failure_scope fs;
+        boost::scope::scope_fail< normal_func, boost::scope::shared_exception_checker > guard1(normal_func(failed), fs.checker());
+        boost::scope::scope_fail< normal_func, boost::scope::shared_exception_checker > guard2(normal_func(failed), fs.checker());
+        boost::scope::scope_success< normal_func, boost::scope::shared_exception_checker > guard3(normal_func(succeeded), fs.checker());
+        throw std::runtime_error("error");
+    }
+    catch (...) {}
+    BOOST_TEST_EQ(failed, 2);
+    BOOST_TEST_EQ(succeeded, 0);
+
+    // The snapshot is taken relative to the exceptions already in flight
+    failed = 0;
+    succeeded = 0;
+    try
+    {
+        boost::scope::scope_exit< nested_guards > outer_guard(nested_guards(failed, succeeded));
+        throw std::runtime_error("error");
+    }
+    catch (...) {}
+    BOOST_TEST_EQ(failed, 0);
+    BOOST_TEST_EQ(succeeded, 1);
+}
+
+void check_deduction()
+{
+#if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
+    int n = 0;
+    try
+    {
+        boost::scope::failure_scope fs;
+        boost::scope::scope_fail guard([&n] { ++n; }, fs.checker());
+        boost::scope::scope_fail guard2([&n] { ++n; }, boost::scope::shared_exception_checker(fs));
+        throw std::runtime_error("error");
+    }
+    catch (...) {}
+    BOOST_TEST_EQ(n, 2);
+#endif
+}
+
+int main()
+{
+    check_normal();
+    check_throw();
+    check_deduction();
+
+    return boost::report_errors();
+}
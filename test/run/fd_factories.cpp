@@ -0,0 +1,192 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   fd_factories.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for file descriptor factory functions.
+ */
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_WINDOWS)
+
+#include <boost/scope/fd_factories.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <system_error>
+
+const char* g_file_name = nullptr;
+
+bool is_cloexec(int fd)
+{
+    const int flags = ::fcntl(fd, F_GETFD);
+    return flags >= 0 && (flags & FD_CLOEXEC) != 0;
+}
+
+void check_open()
+{
+    std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+    boost::scope::unique_fd fd = boost::scope::open_fd(g_file_name, O_RDONLY, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(fd.allocated());
+    BOOST_TEST(is_cloexec(fd.get()));
+
+    boost::scope::unique_fd fd2 = boost::scope::open_fd("/nonexistent/boost_scope_test_file", O_RDONLY, ec);
+    BOOST_TEST(!!ec);
+    BOOST_TEST(ec == std::errc::no_such_file_or_directory);
+    BOOST_TEST(!fd2.allocated());
+}
+
+void check_dup()
+{
+    std::error_code ec;
+    boost::scope::unique_fd fd = boost::scope::open_fd(g_file_name, O_RDONLY, ec);
+    BOOST_TEST(!ec);
+
+    boost::scope::unique_fd fd2 = boost::scope::dup_fd(fd.get(), ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(fd2.allocated());
+    BOOST_TEST_NE(fd2.get(), fd.get());
+    BOOST_TEST(is_cloexec(fd2.get()));
+
+    boost::scope::unique_fd fd3 = boost::scope::dup_fd(fd.get(), 100, ec);
+    if (!ec)
+    {
+        BOOST_TEST_GE(fd3.get(), 100);
+        BOOST_TEST(is_cloexec(fd3.get()));
+    }
+
+    boost::scope::unique_fd fd4 = boost::scope::dup_fd(-1, ec);
+    BOOST_TEST(!!ec);
+    BOOST_TEST(!fd4.allocated());
+}
+
+void check_pipe()
+{
+    std::error_code ec;
+    std::pair< boost::scope::unique_fd, boost::scope::unique_fd > fds = boost::scope::pipe_fds(ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(fds.first.allocated());
+    BOOST_TEST(fds.second.allocated());
+    BOOST_TEST(is_cloexec(fds.first.get()));
+    BOOST_TEST(is_cloexec(fds.second.get()));
+
+    const char data[] = "test";
+    BOOST_TEST_EQ(::write(fds.second.get(), data, sizeof(data)), static_cast< ssize_t >(sizeof(data)));
+    char buf[sizeof(data)] = {};
+    BOOST_TEST_EQ(::read(fds.first.get(), buf, sizeof(buf)), static_cast< ssize_t >(sizeof(data)));
+    BOOST_TEST(std::memcmp(buf, data, sizeof(data)) == 0);
+
+#if defined(BOOST_SCOPE_DETAIL_HAS_PIPE2)
+    fds = boost::scope::pipe_fds(O_NONBLOCK, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST((::fcntl(fds.first.get(), F_GETFL) & O_NONBLOCK) != 0);
+    BOOST_TEST(is_cloexec(fds.first.get()));
+#endif
+}
+
+void check_sockets()
+{
+    std::error_code ec;
+    boost::scope::unique_fd listener = boost::scope::socket_fd(AF_INET, SOCK_STREAM, 0, ec);
+    if (ec)
+    {
+        // Sockets may be unavailable in restricted environments
+        return;
+    }
+    BOOST_TEST(is_cloexec(listener.get()));
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (::bind(listener.get(), reinterpret_cast< struct sockaddr* >(&addr), sizeof(addr)) != 0 || ::listen(listener.get(), 1) != 0)
+        return;
+
+    socklen_t addr_len = sizeof(addr);
+    BOOST_TEST_EQ(::getsockname(listener.get(), reinterpret_cast< struct sockaddr* >(&addr), &addr_len), 0);
+
+    boost::scope::unique_fd client = boost::scope::socket_fd(AF_INET, SOCK_STREAM, 0, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST_EQ(::connect(client.get(), reinterpret_cast< struct sockaddr* >(&addr), sizeof(addr)), 0);
+
+    struct sockaddr_in peer_addr = {};
+    socklen_t peer_addr_len = sizeof(peer_addr);
+    boost::scope::unique_fd server = boost::scope::accept_fd(listener.get(), reinterpret_cast< struct sockaddr* >(&peer_addr), &peer_addr_len, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(server.allocated());
+    BOOST_TEST(is_cloexec(server.get()));
+    BOOST_TEST_EQ(peer_addr.sin_family, AF_INET);
+
+    boost::scope::unique_fd bad = boost::scope::accept_fd(client.get(), ec);
+    BOOST_TEST(!!ec);
+    BOOST_TEST(!bad.allocated());
+}
+
+#if defined(__linux__)
+
+void check_linux()
+{
+    std::error_code ec;
+    boost::scope::unique_fd efd = boost::scope::eventfd_fd(0u, 0, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(efd.allocated());
+    BOOST_TEST(is_cloexec(efd.get()));
+
+    boost::scope::unique_fd mfd = boost::scope::memfd_fd("boost_scope_test", 0u, ec);
+    if (!ec)
+    {
+        BOOST_TEST(mfd.allocated());
+        BOOST_TEST(is_cloexec(mfd.get()));
+    }
+    else
+    {
+        // memfd_create may not be supported by the kernel
+        BOOST_TEST(!mfd.allocated());
+    }
+}
+
+#endif // defined(__linux__)
+
+int main(int argc, char* args[])
+{
+    if (argc > 0)
+    {
+        g_file_name = args[0];
+
+        check_open();
+        check_dup();
+    }
+
+    check_pipe();
+    check_sockets();
+#if defined(__linux__)
+    check_linux();
+#endif
+
+    return boost::report_errors();
+}
+
+#else // !defined(BOOST_WINDOWS)
+
+int main()
+{
+    return 0;
+}
+
+#endif // !defined(BOOST_WINDOWS)
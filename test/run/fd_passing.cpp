@@ -0,0 +1,193 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   fd_passing.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c send_fds and \c recv_fds.
+ */
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_WINDOWS)
+
+#include <boost/scope/fd_passing.hpp>
+#include <boost/scope/fd_factories.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <system_error>
+
+bool make_socket_pair(boost::scope::unique_fd& sock1, boost::scope::unique_fd& sock2)
+{
+    int socks[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, socks) != 0)
+        return false;
+
+    sock1.reset(socks[0]);
+    sock2.reset(socks[1]);
+    return true;
+}
+
+bool same_file(int fd1, int fd2)
+{
+    struct stat st1 = {}, st2 = {};
+    return ::fstat(fd1, &st1) == 0 && ::fstat(fd2, &st2) == 0 && st1.st_dev == st2.st_dev && st1.st_ino == st2.st_ino;
+}
+
+void check_send_recv(int sender, int receiver)
+{
+    std::error_code ec;
+    std::pair< boost::scope::unique_fd, boost::scope::unique_fd > pipe1 = boost::scope::pipe_fds(ec);
+    BOOST_TEST(!ec);
+    std::pair< boost::scope::unique_fd, boost::scope::unique_fd > pipe2 = boost::scope::pipe_fds(ec);
+    BOOST_TEST(!ec);
+
+    std::vector< boost::scope::unique_fd > fds;
+    fds.push_back(std::move(pipe1.first));
+    fds.push_back(std::move(pipe1.second));
+    fds.push_back(std::move(pipe2.first));
+
+    BOOST_TEST_EQ(boost::scope::send_fds(sender, fds, ec), 3u);
+    BOOST_TEST(!ec);
+
+    std::vector< boost::scope::unique_fd > received = boost::scope::recv_fds(receiver, 10u, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST_EQ(received.size(), 3u);
+    for (std::size_t i = 0u, n = received.size() < fds.size() ? received.size() : fds.size(); i < n; ++i)
+    {
+        BOOST_TEST(received[i].allocated());
+        BOOST_TEST_NE(received[i].get(), fds[i].get());
+        BOOST_TEST(same_file(received[i].get(), fds[i].get()));
+        BOOST_TEST((::fcntl(received[i].get(), F_GETFD) & FD_CLOEXEC) != 0);
+    }
+}
+
+void check_many(int sender, int receiver)
+{
+    // Send more file descriptors than fit in a single message
+    std::error_code ec;
+    boost::scope::unique_fd base = boost::scope::dup_fd(sender, ec);
+    BOOST_TEST(!ec);
+
+    const std::size_t count = boost::scope::max_fds_per_message + 10u;
+    std::vector< boost::scope::unique_fd > fds;
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+        boost::scope::unique_fd fd = boost::scope::dup_fd(base.get(), ec);
+        if (ec)
+            return; // the file descriptor limit is too low
+        fds.push_back(std::move(fd));
+    }
+
+    BOOST_TEST_EQ(boost::scope::send_fds(sender, fds.data(), fds.size(), ec), count);
+    BOOST_TEST(!ec);
+    fds.clear();
+
+    std::vector< boost::scope::unique_fd > received = boost::scope::recv_fds(receiver, boost::scope::max_fds_per_message, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST_EQ(received.size(), boost::scope::max_fds_per_message);
+
+    received = boost::scope::recv_fds(receiver, boost::scope::max_fds_per_message, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST_EQ(received.size(), 10u);
+}
+
+void check_truncated(int sender, int receiver)
+{
+    std::error_code ec;
+    std::pair< boost::scope::unique_fd, boost::scope::unique_fd > pipe1 = boost::scope::pipe_fds(ec);
+    BOOST_TEST(!ec);
+    std::pair< boost::scope::unique_fd, boost::scope::unique_fd > pipe2 = boost::scope::pipe_fds(ec);
+    BOOST_TEST(!ec);
+
+    boost::scope::unique_fd fds[4] = { std::move(pipe1.first), std::move(pipe1.second), std::move(pipe2.first), std::move(pipe2.second) };
+    BOOST_TEST_EQ(boost::scope::send_fds(sender, fds, 4u, ec), 4u);
+    BOOST_TEST(!ec);
+
+    // The message contains more file descriptors than the receiver allows, all of them are closed
+    std::vector< boost::scope::unique_fd > received = boost::scope::recv_fds(receiver, 1u, ec);
+    BOOST_TEST(ec == std::errc::message_size);
+    BOOST_TEST(received.empty());
+}
+
+void check_odd_max_count(int sender, int receiver)
+{
+    // With an odd max_count, the control buffer has room for one more file descriptor than requested
+    std::error_code ec;
+    std::pair< boost::scope::unique_fd, boost::scope::unique_fd > pipe = boost::scope::pipe_fds(ec);
+    BOOST_TEST(!ec);
+
+    {
+        boost::scope::unique_fd fds[2] = { boost::scope::dup_fd(pipe.second.get(), ec), std::move(pipe.second) };
+        BOOST_TEST_EQ(boost::scope::send_fds(sender, fds, 2u, ec), 2u);
+        BOOST_TEST(!ec);
+    }
+
+    std::vector< boost::scope::unique_fd > received = boost::scope::recv_fds(receiver, 1u, ec);
+    BOOST_TEST(ec == std::errc::message_size);
+    BOOST_TEST(received.empty());
+
+    // All received write ends of the pipe must have been closed
+    BOOST_TEST_EQ(::fcntl(pipe.first.get(), F_SETFL, ::fcntl(pipe.first.get(), F_GETFL) | O_NONBLOCK), 0);
+    char buf = 0;
+    BOOST_TEST_EQ(::read(pipe.first.get(), &buf, 1u), 0);
+}
+
+void check_errors(int sender)
+{
+    std::error_code ec;
+    boost::scope::unique_fd fds[1] = { boost::scope::dup_fd(sender, ec) };
+    BOOST_TEST(!ec);
+
+    BOOST_TEST_EQ(boost::scope::send_fds(-1, fds, 1u, ec), 0u);
+    BOOST_TEST(!!ec);
+
+    std::vector< boost::scope::unique_fd > received = boost::scope::recv_fds(-1, 1u, ec);
+    BOOST_TEST(!!ec);
+    BOOST_TEST(received.empty());
+
+    // No file descriptors to send
+    BOOST_TEST_EQ(boost::scope::send_fds(sender, fds, 0u, ec), 0u);
+    BOOST_TEST(!ec);
+}
+
+int main()
+{
+    boost::scope::unique_fd sock1, sock2;
+    if (make_socket_pair(sock1, sock2))
+    {
+        check_send_recv(sock1.get(), sock2.get());
+        check_many(sock1.get(), sock2.get());
+        check_truncated(sock2.get(), sock1.get());
+        check_odd_max_count(sock1.get(), sock2.get());
+        check_errors(sock1.get());
+    }
+    else
+    {
+        BOOST_ERROR("Failed to create a socket pair");
+    }
+
+    return boost::report_errors();
+}
+
+#else // !defined(BOOST_WINDOWS)
+
+int main()
+{
+    return 0;
+}
+
+#endif // !defined(BOOST_WINDOWS)
@@ -0,0 +1,248 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   fd_table.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c fd_table.
+ */
+
+#include <boost/config.hpp>
+
+#include <boost/scope/fd_table.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#if defined(BOOST_WINDOWS)
+#include <io.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstdio>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+
+#if defined(BOOST_WINDOWS)
+#define open _open
+#define O_RDONLY _O_RDONLY
+#define stat _stat
+#define fstat _fstat
+#endif // defined(BOOST_WINDOWS)
+
+const char* g_file_name = nullptr;
+
+bool is_open(int fd)
+{
+    struct stat st = {};
+    return ::fstat(fd, &st) == 0;
+}
+
+boost::scope::unique_fd open_fd()
+{
+    return boost::scope::unique_fd(::open(g_file_name, O_RDONLY));
+}
+
+struct connection
+{
+    static int live_count;
+
+    int id;
+
+    explicit connection(int i) : id(i)
+    {
+        ++live_count;
+    }
+
+    ~connection()
+    {
+        --live_count;
+    }
+};
+
+int connection::live_count = 0;
+
+struct throwing_connection
+{
+    explicit throwing_connection(int)
+    {
+        throw std::runtime_error("throwing_connection");
+    }
+};
+
+void check_basic()
+{
+    boost::scope::fd_table< connection > table;
+    BOOST_TEST(table.empty());
+    BOOST_TEST_EQ(table.capacity(), boost::scope::fd_table< connection >::default_capacity);
+
+    boost::scope::unique_fd fd1 = open_fd();
+    const int n1 = fd1.get();
+    BOOST_TEST_GE(n1, 0);
+
+    connection* c1 = table.emplace(std::move(fd1), 1);
+    BOOST_TEST(c1 != nullptr);
+    BOOST_TEST(!fd1.allocated());
+    BOOST_TEST_EQ(table.size(), 1u);
+    BOOST_TEST_EQ(connection::live_count, 1);
+    BOOST_TEST(table.contains(n1));
+    BOOST_TEST_EQ(table.find(n1), c1);
+    BOOST_TEST_EQ(table.find(n1)->id, 1);
+    BOOST_TEST(table.find(n1 + 1) == nullptr);
+    BOOST_TEST(table.find(-1) == nullptr);
+
+    // Unallocated file descriptors are not inserted
+    boost::scope::unique_fd fd_none;
+    BOOST_TEST(table.emplace(std::move(fd_none), 2) == nullptr);
+    BOOST_TEST_EQ(connection::live_count, 1);
+
+    boost::scope::unique_fd fd2 = open_fd();
+    const int n2 = fd2.get();
+    BOOST_TEST(table.emplace(std::move(fd2), 2) != nullptr);
+    BOOST_TEST_EQ(table.size(), 2u);
+
+    // Release does not close the file descriptor
+    boost::scope::unique_fd released = table.release(n2);
+    BOOST_TEST_EQ(released.get(), n2);
+    BOOST_TEST(!table.contains(n2));
+    BOOST_TEST_EQ(table.size(), 1u);
+    BOOST_TEST_EQ(connection::live_count, 1);
+    BOOST_TEST(is_open(n2));
+    BOOST_TEST(!table.release(n2).allocated());
+
+    BOOST_TEST(table.close(n1));
+    BOOST_TEST(!table.close(n1));
+    BOOST_TEST(!is_open(n1));
+    BOOST_TEST(table.empty());
+    BOOST_TEST_EQ(connection::live_count, 0);
+}
+
+void check_limits()
+{
+    boost::scope::fd_table< connection, 4u > table(4u);
+    std::vector< int > fds;
+    while (true)
+    {
+        boost::scope::unique_fd fd = open_fd();
+        const int n = fd.get();
+        if (n >= 4)
+        {
+            // The file descriptor is out of range and is not consumed by the container
+            BOOST_TEST(table.emplace(std::move(fd), n) == nullptr);
+            BOOST_TEST(fd.allocated());
+            break;
+        }
+
+        BOOST_TEST(table.emplace(std::move(fd), n) != nullptr);
+        fds.push_back(n);
+    }
+
+    BOOST_TEST_EQ(table.size(), fds.size());
+
+    // Exceptions from the value constructor leave the file descriptor with the caller
+    boost::scope::fd_table< throwing_connection > throwing_table;
+    boost::scope::unique_fd fd = open_fd();
+    BOOST_TEST_THROWS(throwing_table.emplace(std::move(fd), 0), std::runtime_error);
+    BOOST_TEST(fd.allocated());
+    BOOST_TEST(!throwing_table.contains(fd.get()));
+}
+
+void check_close_all()
+{
+    std::vector< int > fds;
+    {
+        boost::scope::fd_table< connection, 8u > table;
+        for (int i = 0; i < 20; ++i)
+        {
+            boost::scope::unique_fd fd = open_fd();
+            fds.push_back(fd.get());
+            BOOST_TEST(table.emplace(std::move(fd), i) != nullptr);
+        }
+
+        int count = 0, prev_fd = -1;
+        bool ordered = true;
+        table.for_each([&](int fd, connection& c)
+        {
+            ordered = ordered && fd > prev_fd;
+            prev_fd = fd;
+            ++count;
+            (void)c;
+        });
+        BOOST_TEST_EQ(count, 20);
+        BOOST_TEST(ordered);
+
+        BOOST_TEST_EQ(table.close_all(), 20u);
+        BOOST_TEST(table.empty());
+        BOOST_TEST_EQ(connection::live_count, 0);
+        for (int fd : fds)
+            BOOST_TEST(!is_open(fd));
+
+        // The container is usable after closing all file descriptors
+        boost::scope::unique_fd fd = open_fd();
+        fds.assign(1u, fd.get());
+        BOOST_TEST(table.emplace(std::move(fd), 0) != nullptr);
+    }
+
+    // The destructor closes the remaining file descriptors
+    BOOST_TEST(!is_open(fds[0]));
+    BOOST_TEST_EQ(connection::live_count, 0);
+}
+
+void check_concurrent_insert()
+{
+    boost::scope::fd_table< int, 4u > table;
+    const unsigned int thread_count = 4u, fds_per_thread = 32u;
+
+    std::atomic< unsigned int > failures(0u);
+    std::vector< std::thread > threads;
+    for (unsigned int i = 0u; i < thread_count; ++i)
+    {
+        threads.emplace_back([&table, &failures, fds_per_thread]()
+        {
+            for (unsigned int j = 0u; j < fds_per_thread; ++j)
+            {
+                boost::scope::unique_fd fd = open_fd();
+                const int n = fd.get();
+                if (!table.emplace(std::move(fd), n))
+                    failures.fetch_add(1u, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (std::thread& th : threads)
+        th.join();
+
+    BOOST_TEST_EQ(failures.load(std::memory_order_relaxed), 0u);
+    BOOST_TEST_EQ(table.size(), thread_count * fds_per_thread);
+    table.for_each([](int fd, int value)
+    {
+        BOOST_TEST_EQ(fd, value);
+    });
+}
+
+int main(int argc, char* args[])
+{
+    if (argc > 0)
+    {
+        g_file_name = args[0];
+
+        check_basic();
+        check_limits();
+        check_close_all();
+        check_concurrent_insert();
+    }
+    else
+    {
+        std::puts("Test executable file name not provided in process args");
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,138 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   is_trivially_relocatable.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c is_trivially_relocatable trait.
+ */
+
+#include <boost/scope/is_trivially_relocatable.hpp>
+#include <boost/scope/unique_resource.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/scope_fail.hpp>
+#include <boost/scope/scope_success.hpp>
+#include <boost/scope/defer.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/scope/resource_usage_counters.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <new>
+#include <string>
+#include <cstring>
+
+int g_deleted = 0;
+
+struct int_deleter
+{
+    void operator() (int) const noexcept
+    {
+        ++g_deleted;
+    }
+};
+
+struct action
+{
+    void operator() () const noexcept
+    {
+    }
+};
+
+struct string_action
+{
+    std::string str;
+
+    void operator() () const noexcept
+    {
+    }
+};
+
+struct non_trivial_resource
+{
+    int value;
+
+    non_trivial_resource(int v) noexcept : value(v) {}
+    non_trivial_resource(non_trivial_resource const& that) noexcept : value(that.value) {}
+    non_trivial_resource& operator= (non_trivial_resource const& that) noexcept
+    {
+        value = that.value;
+        return *this;
+    }
+};
+
+struct instrumented_int_traits
+{
+    using instrumentation = boost::scope::resource_usage_counters< instrumented_int_traits >;
+
+    static int make_default() noexcept
+    {
+        return -1;
+    }
+
+    static bool is_allocated(int res) noexcept
+    {
+        return res >= 0;
+    }
+};
+
+void check_traits()
+{
+    using boost::scope::is_trivially_relocatable;
+
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< int >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< int& >));
+    BOOST_TEST_TRAIT_FALSE((is_trivially_relocatable< std::string >));
+
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::unique_fd >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::unique_resource< int, int_deleter > >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::unique_resource< int&, int_deleter > >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::unique_resource< int, int_deleter& > >));
+    BOOST_TEST_TRAIT_FALSE((is_trivially_relocatable< boost::scope::unique_resource< non_trivial_resource, int_deleter > >));
+    BOOST_TEST_TRAIT_FALSE((is_trivially_relocatable< boost::scope::unique_resource< int, int_deleter, instrumented_int_traits > >));
+
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::scope_exit< action > >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::scope_exit< action& > >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::scope_exit< void (*)() > >));
+    BOOST_TEST_TRAIT_FALSE((is_trivially_relocatable< boost::scope::scope_exit< string_action > >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::scope_fail< action > >));
+    BOOST_TEST_TRAIT_FALSE((is_trivially_relocatable< boost::scope::scope_fail< string_action > >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::scope_success< action > >));
+    BOOST_TEST_TRAIT_FALSE((is_trivially_relocatable< boost::scope::scope_success< string_action > >));
+    BOOST_TEST_TRAIT_TRUE((is_trivially_relocatable< boost::scope::defer_guard< action > >));
+    BOOST_TEST_TRAIT_FALSE((is_trivially_relocatable< boost::scope::defer_guard< string_action > >));
+}
+
+void check_relocation()
+{
+    using unique_int = boost::scope::unique_resource< int, int_deleter >;
+
+    g_deleted = 0;
+    {
+        alignas(unique_int) unsigned char storage1[sizeof(unique_int)];
+        alignas(unique_int) unsigned char storage2[sizeof(unique_int)];
+        unique_int* p1 = new (storage1) unique_int(10);
+
+        // Relocate the object by copying its representation
+        std::memcpy(storage2, storage1, sizeof(unique_int));
+        unique_int* p2 = reinterpret_cast< unique_int* >(storage2);
+        static_cast< void >(p1);
+
+        BOOST_TEST(p2->allocated());
+        BOOST_TEST_EQ(p2->get(), 10);
+        p2->~unique_int();
+    }
+    BOOST_TEST_EQ(g_deleted, 1);
+}
+
+int main()
+{
+    check_traits();
+    check_relocation();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,202 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   madvise_scope.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c madvise_scope.
+ */
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_WINDOWS)
+
+#include <boost/scope/madvise_scope.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(MAP_ANONYMOUS)
+#define BOOST_SCOPE_TEST_MAP_ANONYMOUS MAP_ANONYMOUS
+#elif defined(MAP_ANON)
+#define BOOST_SCOPE_TEST_MAP_ANONYMOUS MAP_ANON
+#endif
+
+#if defined(BOOST_SCOPE_TEST_MAP_ANONYMOUS)
+
+const std::size_t page_count = 16u;
+
+class region
+{
+private:
+    unsigned char* m_data;
+    std::size_t m_size;
+
+public:
+    region() :
+        m_data(nullptr),
+        m_size(static_cast< std::size_t >(::sysconf(_SC_PAGESIZE)) * page_count)
+    {
+        void* p = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | BOOST_SCOPE_TEST_MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::runtime_error("mmap failed");
+        m_data = static_cast< unsigned char* >(p);
+        std::memset(m_data, 0xA5, m_size);
+    }
+
+    ~region()
+    {
+        ::munmap(m_data, m_size);
+    }
+
+    region(region const&) = delete;
+    region& operator= (region const&) = delete;
+
+    unsigned char* data() const noexcept { return m_data; }
+    std::size_t size() const noexcept { return m_size; }
+
+    bool filled() const noexcept
+    {
+        for (std::size_t i = 0u; i < m_size; ++i)
+        {
+            if (m_data[i] != 0xA5)
+                return false;
+        }
+        return true;
+    }
+
+    bool zeroed() const noexcept
+    {
+        for (std::size_t i = 0u; i < m_size; ++i)
+        {
+            if (m_data[i] != 0u)
+                return false;
+        }
+        return true;
+    }
+};
+
+#if defined(MADV_DONTNEED) && defined(__linux__)
+// MADV_DONTNEED is guaranteed to discard private anonymous pages on Linux
+#define BOOST_SCOPE_TEST_DONTNEED_ZEROES
+#endif
+
+void check_normal()
+{
+    region r;
+    {
+        boost::scope::madvise_scope guard(r.data(), r.size(), boost::scope::madvise_hints::willneed | boost::scope::madvise_hints::hugepage,
+            boost::scope::madvise_hints::cold | boost::scope::madvise_hints::dontneed);
+        BOOST_TEST(guard.active());
+        BOOST_TEST(r.filled());
+    }
+#if defined(BOOST_SCOPE_TEST_DONTNEED_ZEROES)
+    BOOST_TEST(r.zeroed());
+#endif
+}
+
+void check_exception()
+{
+    region r;
+    try
+    {
+        boost::scope::madvise_scope guard(r.data(), r.size(), boost::scope::madvise_hints::willneed, boost::scope::madvise_hints::dontneed);
+        throw std::runtime_error("error");
+    }
+    catch (std::runtime_error&)
+    {
+    }
+#if defined(BOOST_SCOPE_TEST_DONTNEED_ZEROES)
+    BOOST_TEST(r.zeroed());
+#endif
+}
+
+void check_inactive()
+{
+    region r;
+    {
+        boost::scope::madvise_scope guard(r.data(), r.size(), boost::scope::madvise_hints::none, boost::scope::madvise_hints::dontneed, false);
+        BOOST_TEST(!guard.active());
+    }
+    BOOST_TEST(r.filled());
+
+    {
+        boost::scope::madvise_scope guard(r.data(), r.size(), boost::scope::madvise_hints::none, boost::scope::madvise_hints::dontneed);
+        guard.set_active(false);
+    }
+    BOOST_TEST(r.filled());
+}
+
+void check_move()
+{
+    region r;
+    {
+        boost::scope::madvise_scope guard1(r.data(), r.size(), boost::scope::madvise_hints::none, boost::scope::madvise_hints::dontneed);
+        boost::scope::madvise_scope guard2(std::move(guard1));
+        BOOST_TEST(!guard1.active());
+        BOOST_TEST(guard2.active());
+        BOOST_TEST(r.filled());
+    }
+#if defined(BOOST_SCOPE_TEST_DONTNEED_ZEROES)
+    BOOST_TEST(r.zeroed());
+#endif
+}
+
+void check_error_code()
+{
+    region r;
+    std::error_code ec;
+    {
+        boost::scope::madvise_scope guard(r.data(), r.size(), boost::scope::madvise_hints::willneed, boost::scope::madvise_hints::none, ec);
+        BOOST_TEST(!ec);
+    }
+    BOOST_TEST(r.filled());
+
+    {
+        // Misaligned address
+        boost::scope::madvise_scope guard(r.data() + 1, r.size() - 1u, boost::scope::madvise_hints::willneed, boost::scope::madvise_hints::none, ec);
+        BOOST_TEST(!!ec);
+    }
+    BOOST_TEST(r.filled());
+}
+
+int main()
+{
+    BOOST_TEST(boost::scope::is_trivially_relocatable< boost::scope::madvise_scope >::value);
+
+    check_normal();
+    check_exception();
+    check_inactive();
+    check_move();
+    check_error_code();
+
+    return boost::report_errors();
+}
+
+#else // defined(BOOST_SCOPE_TEST_MAP_ANONYMOUS)
+
+int main()
+{
+    return 0;
+}
+
+#endif // defined(BOOST_SCOPE_TEST_MAP_ANONYMOUS)
+
+#else // !defined(BOOST_WINDOWS)
+
+int main()
+{
+    return 0;
+}
+
+#endif // !defined(BOOST_WINDOWS)
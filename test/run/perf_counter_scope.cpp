@@ -0,0 +1,163 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   perf_counter_scope.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c perf_counter_scope.
+ *
+ * Performance counters may not be available in the test environment, in which case
+ * the tests only verify that the scope guard does nothing.
+ */
+
+#include <boost/config.hpp>
+
+#if defined(__linux__)
+
+#include <boost/scope/perf_counter_scope.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+volatile std::uint64_t g_sink = 0u;
+
+void busy_loop()
+{
+    std::uint64_t x = 0u;
+    for (unsigned int i = 0u; i < 5000000u; ++i)
+        x += i * i;
+    g_sink = x;
+}
+
+void check_values(boost::scope::perf_counter_values const& values, boost::scope::perf_counter_source source, std::uint64_t scopes)
+{
+    switch (source)
+    {
+    case boost::scope::perf_counter_source::hardware:
+        BOOST_TEST(values.source == boost::scope::perf_counter_source::hardware);
+        BOOST_TEST_EQ(values.scopes, scopes);
+        BOOST_TEST_GT(values.instructions, 0u);
+        BOOST_TEST_GT(values.cycles, 0u);
+        BOOST_TEST_EQ(values.task_clock, 0u);
+        break;
+
+    case boost::scope::perf_counter_source::software:
+        BOOST_TEST(values.source == boost::scope::perf_counter_source::software);
+        BOOST_TEST_EQ(values.scopes, scopes);
+        BOOST_TEST_GT(values.task_clock, 0u);
+        BOOST_TEST_EQ(values.instructions, 0u);
+        break;
+
+    default:
+        BOOST_TEST(values.source == boost::scope::perf_counter_source::none);
+        BOOST_TEST_EQ(values.scopes, 0u);
+        BOOST_TEST_EQ(values.cycles, 0u);
+        BOOST_TEST_EQ(values.instructions, 0u);
+        BOOST_TEST_EQ(values.task_clock, 0u);
+        break;
+    }
+}
+
+void check_thread_slot()
+{
+    const boost::scope::perf_counter_source source = boost::scope::this_thread_perf_counter_source();
+
+    boost::scope::this_thread_perf_counters() = boost::scope::perf_counter_values();
+    {
+        boost::scope::perf_counter_scope guard;
+        busy_loop();
+    }
+    check_values(boost::scope::this_thread_perf_counters(), source, 1u);
+
+    {
+        boost::scope::perf_counter_scope guard;
+        busy_loop();
+    }
+    check_values(boost::scope::this_thread_perf_counters(), source, 2u);
+
+    boost::scope::this_thread_perf_counters() = boost::scope::perf_counter_values();
+    check_values(boost::scope::this_thread_perf_counters(), boost::scope::perf_counter_source::none, 0u);
+}
+
+void check_explicit_slot()
+{
+    const boost::scope::perf_counter_source source = boost::scope::this_thread_perf_counter_source();
+
+    boost::scope::this_thread_perf_counters() = boost::scope::perf_counter_values();
+    boost::scope::perf_counter_values outer = {};
+    boost::scope::perf_counter_values inner = {};
+    {
+        boost::scope::perf_counter_scope outer_guard(outer);
+        busy_loop();
+        {
+            boost::scope::perf_counter_scope inner_guard(inner);
+            busy_loop();
+        }
+    }
+    check_values(outer, source, 1u);
+    check_values(inner, source, 1u);
+    // The thread slot is not affected
+    BOOST_TEST_EQ(boost::scope::this_thread_perf_counters().scopes, 0u);
+
+    if (source == boost::scope::perf_counter_source::hardware)
+        BOOST_TEST_GE(outer.instructions, inner.instructions);
+}
+
+void check_context_switches()
+{
+    const boost::scope::perf_counter_source source = boost::scope::this_thread_perf_counter_source();
+
+    boost::scope::perf_counter_values values = {};
+    {
+        boost::scope::perf_counter_scope guard(values);
+        // Blocking sleeps cause voluntary context switches
+        for (unsigned int i = 0u; i < 10u; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (source == boost::scope::perf_counter_source::software)
+        BOOST_TEST_GE(values.context_switches, 10u);
+    else
+        BOOST_TEST_EQ(values.context_switches, 0u);
+}
+
+void check_threads()
+{
+    boost::scope::perf_counter_values values = {};
+    std::thread t([&values]()
+    {
+        {
+            boost::scope::perf_counter_scope guard;
+            busy_loop();
+        }
+        values = boost::scope::this_thread_perf_counters();
+    });
+    t.join();
+
+    check_values(values, values.source, values.source == boost::scope::perf_counter_source::none ? 0u : 1u);
+}
+
+int main()
+{
+    check_thread_slot();
+    check_explicit_slot();
+    check_context_switches();
+    check_threads();
+
+    return boost::report_errors();
+}
+
+#else // defined(__linux__)
+
+int main()
+{
+    return 0;
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,195 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   result_checker.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c result_checker and \c errno_checker.
+ */
+
+#include <boost/scope/result_checker.hpp>
+#include <boost/scope/errno_checker.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/scope/scope_fail.hpp>
+#include <boost/scope/scope_success.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <boost/config.hpp>
+#include <cerrno>
+#include <system_error>
+#include "function_types.hpp"
+
+// A minimal \c std::expected-like result type
+template< typename T >
+class test_result
+{
+private:
+    T m_value;
+    std::error_code m_error;
+
+public:
+    explicit test_result(T value) noexcept :
+        m_value(value),
+        m_error()
+    {
+    }
+
+    explicit test_result(std::error_code err) noexcept :
+        m_value(),
+        m_error(err)
+    {
+    }
+
+    bool has_value() const noexcept
+    {
+        return !m_error;
+    }
+
+    std::error_code error() const noexcept
+    {
+        return m_error;
+    }
+};
+
+test_result< int > parse_digit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return test_result< int >(c - '0');
+    return test_result< int >(std::make_error_code(std::errc::invalid_argument));
+}
+
+void check_result()
+{
+    int n = 0;
+    {
+        test_result< int > res(0);
+        boost::scope::scope_fail< normal_func, boost::scope::result_checker< test_result< int > > > guard{ normal_func(n), boost::scope::check_result(res) };
+        res = parse_digit('1');
+    }
+    BOOST_TEST_EQ(n, 0);
+
+    n = 0;
+    {
+        test_result< int > res(0);
+        boost::scope::scope_fail< normal_func, boost::scope::result_checker< test_result< int > > > guard{ normal_func(n), boost::scope::check_result(res) };
+        res = parse_digit('x');
+    }
+    BOOST_TEST_EQ(n, 1);
+
+    n = 0;
+    {
+        test_result< int > res(0);
+        boost::scope::scope_success< normal_func, boost::scope::result_checker< test_result< int > > > guard{ normal_func(n), boost::scope::check_result(res) };
+        res = parse_digit('x');
+    }
+    BOOST_TEST_EQ(n, 0);
+
+    n = 0;
+    {
+        test_result< int > res(0);
+        boost::scope::scope_fail< normal_func, boost::scope::result_checker< test_result< int > > > guard{ normal_func(n), boost::scope::check_result(res), false };
+        res = parse_digit('x');
+    }
+    BOOST_TEST_EQ(n, 0);
+
+    {
+        test_result< int > const res(std::make_error_code(std::errc::invalid_argument));
+        boost::scope::result_checker< test_result< int > const > checker(res);
+        BOOST_TEST(checker());
+    }
+}
+
+void check_errno()
+{
+    int n = 0;
+    {
+        errno = 0;
+        boost::scope::scope_fail< normal_func, boost::scope::errno_checker > guard{ normal_func(n), boost::scope::check_errno() };
+    }
+    BOOST_TEST_EQ(n, 0);
+
+    n = 0;
+    {
+        errno = 0;
+        boost::scope::scope_fail< normal_func, boost::scope::errno_checker > guard{ normal_func(n), boost::scope::check_errno() };
+        errno = EINVAL;
+    }
+    BOOST_TEST_EQ(n, 1);
+
+    n = 0;
+    {
+        // The error that was already present on construction is cleared and not reported
+        errno = EINVAL;
+        boost::scope::scope_fail< normal_func, boost::scope::errno_checker > guard{ normal_func(n), boost::scope::check_errno() };
+        BOOST_TEST_EQ(errno, 0);
+        BOOST_TEST_EQ(guard.active(), true);
+    }
+    BOOST_TEST_EQ(n, 0);
+
+    n = 0;
+    {
+        // A new error is reported even if it is equal to the error present on construction
+        errno = EINVAL;
+        boost::scope::scope_fail< normal_func, boost::scope::errno_checker > guard{ normal_func(n), boost::scope::check_errno() };
+        errno = EINVAL;
+    }
+    BOOST_TEST_EQ(n, 1);
+
+    n = 0;
+    {
+        errno = EINVAL;
+        boost::scope::errno_checker checker;
+        BOOST_TEST_EQ(checker.captured_errno(), EINVAL);
+        BOOST_TEST_EQ(errno, 0);
+        boost::scope::scope_success< normal_func, boost::scope::errno_checker > guard{ normal_func(n), checker };
+        errno = ENOENT;
+    }
+    BOOST_TEST_EQ(n, 0);
+
+    n = 0;
+    {
+        errno = 0;
+        boost::scope::scope_success< normal_func, boost::scope::errno_checker > guard{ normal_func(n), boost::scope::check_errno() };
+    }
+    BOOST_TEST_EQ(n, 1);
+
+    errno = 0;
+}
+
+void check_deduction()
+{
+#if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
+    int n = 0;
+    {
+        test_result< int > res(0);
+        boost::scope::scope_fail guard{ normal_func(n), boost::scope::check_result(res) };
+        BOOST_TEST_TRAIT_SAME(decltype(guard), boost::scope::scope_fail< normal_func, boost::scope::result_checker< test_result< int > > >);
+        res = parse_digit('x');
+    }
+    BOOST_TEST_EQ(n, 1);
+
+    n = 0;
+    {
+        errno = 0;
+        boost::scope::scope_fail guard{ normal_func(n), boost::scope::check_errno() };
+        BOOST_TEST_TRAIT_SAME(decltype(guard), boost::scope::scope_fail< normal_func, boost::scope::errno_checker >);
+        errno = EIO;
+    }
+    BOOST_TEST_EQ(n, 1);
+    errno = 0;
+#endif
+}
+
+int main()
+{
+    check_result();
+    check_errno();
+    check_deduction();
+
+    return boost::report_errors();
+}
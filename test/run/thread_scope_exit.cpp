@@ -0,0 +1,278 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   thread_scope_exit.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c thread_scope_exit.
+ */
+
+// Count assertion failures instead of aborting, to test the overflow behavior
+#define BOOST_ENABLE_ASSERT_HANDLER
+
+#include <boost/scope/thread_scope_exit.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <type_traits>
+
+std::atomic< unsigned int > g_assertion_failures(0u);
+
+namespace boost {
+
+void assertion_failed(char const*, char const*, char const*, long)
+{
+    ++g_assertion_failures;
+}
+
+void assertion_failed_msg(char const*, char const*, char const*, char const*, long)
+{
+    ++g_assertion_failures;
+}
+
+} // namespace boost
+
+struct recorder
+{
+    std::vector< int >* log;
+    int id;
+
+    void operator() () const
+    {
+        log->push_back(id);
+    }
+};
+
+void check_lifo_order()
+{
+    std::vector< int > log;
+    std::thread th([&log]()
+    {
+        boost::scope::thread_scope_exit h1(recorder{ &log, 1 });
+        boost::scope::thread_scope_exit h2(recorder{ &log, 2 });
+        boost::scope::thread_scope_exit h3(recorder{ &log, 3 });
+        // Destroying the handles does not affect the registered actions
+    });
+    th.join();
+
+    BOOST_TEST_EQ(log.size(), 3u);
+    if (log.size() == 3u)
+    {
+        BOOST_TEST_EQ(log[0], 3);
+        BOOST_TEST_EQ(log[1], 2);
+        BOOST_TEST_EQ(log[2], 1);
+    }
+}
+
+void check_activation()
+{
+    std::vector< int > log;
+    bool state_ok = true;
+    std::thread th([&log, &state_ok]()
+    {
+        boost::scope::thread_scope_exit h1(recorder{ &log, 1 });
+        boost::scope::thread_scope_exit h2(recorder{ &log, 2 }, false);
+        boost::scope::thread_scope_exit h3(recorder{ &log, 3 }, false);
+        boost::scope::thread_scope_exit h4(recorder{ &log, 4 });
+
+        state_ok = h1.registered() && h1.active() && h2.registered() && !h2.active();
+
+        h1.set_active(false);
+        h3.set_active(true);
+        state_ok = state_ok && !h1.active() && h3.active();
+
+        h4.release();
+        state_ok = state_ok && !h4.registered() && !h4.active();
+    });
+    th.join();
+
+    BOOST_TEST(state_ok);
+    BOOST_TEST_EQ(log.size(), 1u);
+    if (log.size() == 1u)
+    {
+        BOOST_TEST_EQ(log[0], 3);
+    }
+}
+
+void check_release()
+{
+    std::vector< int > log;
+    std::thread th([&log]()
+    {
+        boost::scope::thread_scope_exit h1(recorder{ &log, 1 });
+        boost::scope::thread_scope_exit h2(recorder{ &log, 2 });
+        // Releasing an action in the middle of the list keeps the order of the remaining actions
+        h1.release();
+        boost::scope::thread_scope_exit h3(recorder{ &log, 3 });
+        h3.release();
+        boost::scope::thread_scope_exit h4(recorder{ &log, 4 });
+    });
+    th.join();
+
+    BOOST_TEST_EQ(log.size(), 2u);
+    if (log.size() == 2u)
+    {
+        BOOST_TEST_EQ(log[0], 4);
+        BOOST_TEST_EQ(log[1], 2);
+    }
+}
+
+void check_move()
+{
+    bool state_ok = true;
+    int n = 0;
+    std::thread th([&n, &state_ok]()
+    {
+        boost::scope::thread_scope_exit h1([&n]() { ++n; });
+        boost::scope::thread_scope_exit h2(std::move(h1));
+        state_ok = !h1.registered() && h2.registered() && h2.active();
+
+        boost::scope::thread_scope_exit h3;
+        state_ok = state_ok && !h3 && !h3.active();
+        h3 = std::move(h2);
+        state_ok = state_ok && !!h3 && !h2;
+    });
+    th.join();
+
+    BOOST_TEST(state_ok);
+    BOOST_TEST_EQ(n, 1);
+}
+
+void check_nested_registration()
+{
+    std::vector< int > log;
+    std::thread th([&log]()
+    {
+        boost::scope::thread_scope_exit h1(recorder{ &log, 1 });
+        boost::scope::thread_scope_exit h2([&log]()
+        {
+            log.push_back(2);
+            // The action registered on thread exit is executed next
+            boost::scope::thread_scope_exit h3(recorder{ &log, 3 });
+        });
+    });
+    th.join();
+
+    BOOST_TEST_EQ(log.size(), 3u);
+    if (log.size() == 3u)
+    {
+        BOOST_TEST_EQ(log[0], 2);
+        BOOST_TEST_EQ(log[1], 3);
+        BOOST_TEST_EQ(log[2], 1);
+    }
+}
+
+//! Action that records its construction, invocation and destruction
+struct tracked_action
+{
+    std::vector< int >* log;
+    int id;
+    bool alive;
+
+    tracked_action(std::vector< int >* l, int i) noexcept : log(l), id(i), alive(true) {}
+    tracked_action(tracked_action const& that) noexcept : log(that.log), id(that.id), alive(that.alive) {}
+    ~tracked_action()
+    {
+        alive = false;
+        log->push_back(-id);
+    }
+
+    void operator() () const
+    {
+        log->push_back(alive ? id : 0);
+        if (id == 2)
+        {
+            // Register a nested action while this action is running
+            boost::scope::thread_scope_exit h(tracked_action(log, 3));
+        }
+    }
+};
+
+void check_nested_registration_nontrivial()
+{
+    std::vector< int > log;
+    std::thread th([&log]()
+    {
+        boost::scope::thread_scope_exit h1(tracked_action(&log, 1));
+        boost::scope::thread_scope_exit h2(tracked_action(&log, 2));
+        // Discard the destruction records of the temporaries
+        log.clear();
+    });
+    th.join();
+
+    // Action 2 runs, registers action 3 (the temporary is destroyed immediately), then action 2 is destroyed,
+    // then action 3 runs and is destroyed, then action 1 runs and is destroyed.
+    const int expected[] = { 2, -3, -2, 3, -3, 1, -1 };
+    BOOST_TEST_ALL_EQ(log.begin(), log.end(), expected, expected + sizeof(expected) / sizeof(*expected));
+}
+
+void check_capacity()
+{
+    int n = 0;
+    unsigned int registered = 0u;
+    bool overflow_ok = true;
+    std::thread th([&n, &registered, &overflow_ok]()
+    {
+        for (unsigned int i = 0u; i < BOOST_SCOPE_THREAD_EXIT_MAX_ACTIONS; ++i)
+        {
+            boost::scope::thread_scope_exit h([&n]() { ++n; });
+            if (h.registered())
+                ++registered;
+        }
+
+        const unsigned int failures = g_assertion_failures;
+        boost::scope::thread_scope_exit h([&n]() { n += 100; });
+        // Overflow is reported by an assertion
+        overflow_ok = !h.registered() && g_assertion_failures == failures + 1u;
+    });
+    th.join();
+
+    BOOST_TEST_EQ(registered, static_cast< unsigned int >(BOOST_SCOPE_THREAD_EXIT_MAX_ACTIONS));
+    BOOST_TEST(overflow_ok);
+    BOOST_TEST_EQ(n, BOOST_SCOPE_THREAD_EXIT_MAX_ACTIONS);
+}
+
+void check_threads_isolated()
+{
+    int n1 = 0, n2 = 0;
+    std::thread th1([&n1]()
+    {
+        boost::scope::thread_scope_exit h([&n1]() { ++n1; });
+    });
+    std::thread th2([&n2]()
+    {
+        boost::scope::thread_scope_exit h1([&n2]() { ++n2; });
+        boost::scope::thread_scope_exit h2([&n2]() { ++n2; });
+    });
+    th1.join();
+    th2.join();
+
+    BOOST_TEST_EQ(n1, 1);
+    BOOST_TEST_EQ(n2, 2);
+}
+
+int main()
+{
+    BOOST_TEST(std::is_nothrow_move_constructible< boost::scope::thread_scope_exit >::value);
+    BOOST_TEST(!std::is_copy_constructible< boost::scope::thread_scope_exit >::value);
+
+    check_lifo_order();
+    check_activation();
+    check_release();
+    check_move();
+    check_nested_registration();
+    check_nested_registration_nontrivial();
+    check_capacity();
+    check_threads_isolated();
+
+    BOOST_TEST_EQ(g_assertion_failures.load(), 1u);
+
+    return boost::report_errors();
+}
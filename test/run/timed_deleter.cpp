@@ -0,0 +1,196 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   timed_deleter.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c timed_deleter and \c latency_histogram.
+ */
+
+#include <boost/scope/timed_deleter.hpp>
+#include <boost/scope/latency_histogram.hpp>
+#include <boost/scope/tsc_clock.hpp>
+#include <boost/scope/unique_resource.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstdint>
+#include <ratio>
+#include <chrono>
+#include <type_traits>
+#include <thread>
+
+int g_deleted = 0;
+
+struct int_deleter
+{
+    void operator() (int) const noexcept
+    {
+        ++g_deleted;
+    }
+};
+
+//! A deleter that is only invocable as a non-const object
+struct mutable_int_deleter
+{
+    int calls = 0;
+
+    void operator() (int) noexcept
+    {
+        ++calls;
+        ++g_deleted;
+    }
+};
+
+//! A fake clock that advances by a fixed number of ticks on every call
+struct step_clock
+{
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration< rep, period >;
+    using time_point = std::chrono::time_point< step_clock, duration >;
+
+    static BOOST_CONSTEXPR_OR_CONST bool is_steady = true;
+
+    static rep& counter() noexcept
+    {
+        static thread_local rep value = 0;
+        return value;
+    }
+
+    static time_point now() noexcept
+    {
+        rep& value = counter();
+        value += 100;
+        return time_point(duration(value));
+    }
+};
+
+void check_histogram()
+{
+    using boost::scope::latency_histogram;
+
+    for (std::uint64_t i = 0u; i < latency_histogram::sub_bucket_count; ++i)
+        BOOST_TEST_EQ(latency_histogram::bucket_index(i), static_cast< std::size_t >(i));
+
+    for (std::size_t i = 0u; i < latency_histogram::bucket_count; ++i)
+    {
+        BOOST_TEST_EQ(latency_histogram::bucket_index(latency_histogram::bucket_lower_bound(i)), i);
+        BOOST_TEST_EQ(latency_histogram::bucket_index(latency_histogram::bucket_upper_bound(i)), i);
+    }
+    BOOST_TEST_EQ(latency_histogram::bucket_index(~static_cast< std::uint64_t >(0u)), latency_histogram::bucket_count - 1u);
+
+    latency_histogram hist;
+    BOOST_TEST(hist.empty());
+    BOOST_TEST_EQ(hist.value_at_quantile(0.5), 0u);
+
+    for (std::uint64_t i = 1u; i <= 100u; ++i)
+        hist.record(i);
+    BOOST_TEST(!hist.empty());
+    BOOST_TEST_EQ(hist.total_count(), 100u);
+    BOOST_TEST_EQ(hist.sum(), 5050u);
+
+    // The relative error of the quantile estimate is bounded by the sub-bucket width
+    const std::uint64_t median = hist.value_at_quantile(0.5);
+    BOOST_TEST_GE(median, 50u);
+    BOOST_TEST_LE(median, 50u + 50u / latency_histogram::sub_bucket_count);
+    BOOST_TEST_GE(hist.value_at_quantile(1.0), 100u);
+    BOOST_TEST_EQ(hist.value_at_quantile(0.0), 1u);
+
+    latency_histogram hist2;
+    hist2.record(1000u, 10u);
+    hist.merge(hist2);
+    BOOST_TEST_EQ(hist.total_count(), 110u);
+    BOOST_TEST_EQ(hist.sum(), 15050u);
+    BOOST_TEST_EQ(hist.bucket(latency_histogram::bucket_index(1000u)), 10u);
+
+    hist.clear();
+    BOOST_TEST(hist.empty());
+    BOOST_TEST_EQ(hist.sum(), 0u);
+}
+
+struct tag1;
+struct tag2;
+
+void check_timed_deleter()
+{
+    using deleter = boost::scope::timed_deleter< int_deleter, step_clock, tag1 >;
+    using unique_int = boost::scope::unique_resource< int, deleter >;
+
+    g_deleted = 0;
+    deleter::clear();
+    {
+        unique_int ur1(10);
+        unique_int ur2(20);
+        ur2.reset();
+        BOOST_TEST_EQ(g_deleted, 1);
+    }
+    BOOST_TEST_EQ(g_deleted, 2);
+
+    boost::scope::latency_histogram hist = deleter::snapshot();
+    BOOST_TEST_EQ(hist.total_count(), 2u);
+    BOOST_TEST_EQ(hist.sum(), 200u);
+    BOOST_TEST_EQ(hist.bucket(boost::scope::latency_histogram::bucket_index(100u)), 2u);
+
+    // Histograms for different tags are separate
+    using deleter2 = boost::scope::timed_deleter< int_deleter, step_clock, tag2 >;
+    BOOST_TEST(deleter2::snapshot().empty());
+
+    // Values recorded by other threads, including terminated ones, are included in the snapshot
+    std::thread th([]()
+    {
+        deleter del;
+        del(1);
+        del(2);
+    });
+    th.join();
+
+    hist = deleter::snapshot();
+    BOOST_TEST_EQ(hist.total_count(), 4u);
+    BOOST_TEST_EQ(hist.sum(), 400u);
+
+    deleter::clear();
+    BOOST_TEST(deleter::snapshot().empty());
+}
+
+void check_mutable_deleter()
+{
+    using deleter = boost::scope::timed_deleter< mutable_int_deleter, step_clock, struct mutable_tag >;
+
+    deleter del;
+    del(1);
+    del(2);
+    BOOST_TEST_EQ(del.get_deleter().calls, 2);
+
+    boost::scope::unique_resource< int, deleter > res(10);
+    res.reset();
+    BOOST_TEST_EQ(res.get_deleter().get_deleter().calls, 1);
+
+    BOOST_TEST_EQ(deleter::snapshot().total_count(), 3u);
+    deleter::clear();
+}
+
+void check_tsc_clock()
+{
+    BOOST_TEST((std::is_same< boost::scope::tsc_clock::period, std::ratio< 1 > >::value));
+
+    using deleter = boost::scope::timed_deleter< int_deleter, boost::scope::tsc_clock >;
+
+    deleter del;
+    del(1);
+
+    BOOST_TEST_EQ(deleter::snapshot().total_count(), 1u);
+}
+
+int main()
+{
+    check_histogram();
+    check_timed_deleter();
+    check_mutable_deleter();
+    check_tsc_clock();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,204 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   trace_scope.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c trace_scope.
+ */
+
+#include <boost/scope/trace_scope.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+struct collected_record
+{
+    std::thread::id thread_id;
+    boost::scope::trace_record record;
+};
+
+struct collector
+{
+    std::vector< collected_record >* records;
+
+    void operator() (std::thread::id thread_id, boost::scope::trace_record const* recs, std::size_t count) const
+    {
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            collected_record rec = { thread_id, recs[i] };
+            records->push_back(rec);
+        }
+    }
+};
+
+//! Collects the sizes of the passed record sequences and throws on the second sequence
+struct throwing_collector
+{
+    std::vector< std::size_t >* sizes;
+
+    void operator() (std::thread::id, boost::scope::trace_record const*, std::size_t count) const
+    {
+        sizes->push_back(count);
+        if (sizes->size() == 2u)
+            throw std::runtime_error("throwing_collector");
+    }
+};
+
+std::vector< collected_record > drain(std::uint64_t* dropped = nullptr)
+{
+    std::vector< collected_record > records;
+    collector c = { &records };
+    const std::uint64_t n = boost::scope::drain_trace_records(c);
+    if (dropped)
+        *dropped = n;
+    return records;
+}
+
+void traced_function()
+{
+    BOOST_SCOPE_TRACE("inner");
+}
+
+void check_single_thread()
+{
+    drain();
+
+    {
+        boost::scope::trace_scope guard("outer");
+        traced_function();
+    }
+
+    std::vector< collected_record > records = drain();
+    BOOST_TEST_EQ(records.size(), 4u);
+    if (records.size() == 4u)
+    {
+        BOOST_TEST(records[0].record.event == boost::scope::trace_event::begin);
+        BOOST_TEST_EQ(std::strcmp(records[0].record.name, "outer"), 0);
+        BOOST_TEST(records[1].record.event == boost::scope::trace_event::begin);
+        BOOST_TEST_EQ(std::strcmp(records[1].record.name, "inner"), 0);
+        BOOST_TEST(records[2].record.event == boost::scope::trace_event::end);
+        BOOST_TEST_EQ(std::strcmp(records[2].record.name, "inner"), 0);
+        BOOST_TEST(records[3].record.event == boost::scope::trace_event::end);
+        BOOST_TEST_EQ(std::strcmp(records[3].record.name, "outer"), 0);
+        BOOST_TEST(records[0].thread_id == std::this_thread::get_id());
+    }
+
+    BOOST_TEST(drain().empty());
+}
+
+void check_overflow()
+{
+    drain();
+
+    const std::size_t capacity = BOOST_SCOPE_TRACE_BUFFER_SIZE;
+    for (std::size_t i = 0u; i < capacity; ++i)
+    {
+        BOOST_SCOPE_TRACE("overflow");
+    }
+
+    std::uint64_t dropped = 0u;
+    std::vector< collected_record > records = drain(&dropped);
+    BOOST_TEST_EQ(records.size(), capacity);
+    BOOST_TEST_EQ(dropped, capacity);
+
+    // The buffer is usable after draining, including wrapping around its end
+    {
+        BOOST_SCOPE_TRACE("shift");
+    }
+    records = drain(&dropped);
+    BOOST_TEST_EQ(records.size(), 2u);
+    BOOST_TEST_EQ(dropped, 0u);
+
+    for (std::size_t i = 0u; i < capacity / 2u; ++i)
+    {
+        BOOST_SCOPE_TRACE("wrap");
+    }
+
+    records = drain(&dropped);
+    BOOST_TEST_EQ(records.size(), capacity);
+    BOOST_TEST_EQ(dropped, 0u);
+    for (std::size_t i = 0u; i < records.size(); ++i)
+        BOOST_TEST(records[i].record.event == ((i & 1u) == 0u ? boost::scope::trace_event::begin : boost::scope::trace_event::end));
+}
+
+void check_drain_failure()
+{
+    const std::size_t capacity = BOOST_SCOPE_TRACE_BUFFER_SIZE;
+    std::vector< std::size_t > sizes;
+    for (unsigned int attempt = 0u; attempt < 2u && sizes.size() < 2u; ++attempt)
+    {
+        // Shift the buffer position so that the full buffer wraps around its end
+        drain();
+        {
+            BOOST_SCOPE_TRACE("shift");
+        }
+        drain();
+
+        for (std::size_t i = 0u; i < capacity / 2u; ++i)
+        {
+            BOOST_SCOPE_TRACE("wrap");
+        }
+
+        sizes.clear();
+        throwing_collector c = { &sizes };
+        try
+        {
+            boost::scope::drain_trace_records(c);
+        }
+        catch (std::runtime_error&) {}
+    }
+
+    BOOST_TEST_EQ(sizes.size(), 2u);
+    if (sizes.size() == 2u)
+    {
+        // The first sequence was consumed, the second one is still in the buffer
+        std::vector< collected_record > records = drain();
+        BOOST_TEST_EQ(records.size(), capacity - sizes[0]);
+        BOOST_TEST_EQ(records.size(), sizes[1]);
+    }
+}
+
+void check_multiple_threads()
+{
+    drain();
+
+    std::thread::id thread_id;
+    std::thread th([&thread_id]()
+    {
+        thread_id = std::this_thread::get_id();
+        BOOST_SCOPE_TRACE("thread");
+    });
+    th.join();
+
+    // Records of the terminated thread are still available
+    std::vector< collected_record > records = drain();
+    BOOST_TEST_EQ(records.size(), 2u);
+    if (records.size() == 2u)
+    {
+        BOOST_TEST(records[0].thread_id == thread_id);
+        BOOST_TEST(records[0].record.event == boost::scope::trace_event::begin);
+        BOOST_TEST(records[1].record.event == boost::scope::trace_event::end);
+    }
+
+    BOOST_TEST(drain().empty());
+}
+
+int main()
+{
+    check_single_thread();
+    check_overflow();
+    check_drain_failure();
+    check_multiple_threads();
+
+    return boost::report_errors();
+}
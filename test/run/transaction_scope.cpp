@@ -0,0 +1,272 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   transaction_scope.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c transaction_scope.
+ */
+
+#include <boost/scope/transaction_scope.hpp>
+#include <boost/scope/error_code_checker.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+// warning C4702: unreachable code
+#pragma warning(disable: 4702)
+#endif
+
+struct undo_step
+{
+    std::vector< int >* log;
+    int id;
+
+    void operator() () const
+    {
+        log->push_back(id);
+    }
+};
+
+struct counted_undo
+{
+    static int live;
+
+    int* counter;
+
+    explicit counted_undo(int& c) noexcept : counter(&c) { ++live; }
+    counted_undo(counted_undo const& that) noexcept : counter(that.counter) { ++live; }
+    ~counted_undo() { --live; }
+
+    void operator() () const noexcept
+    {
+        ++(*counter);
+    }
+};
+
+int counted_undo::live = 0;
+
+struct throw_on_copy_undo
+{
+    int* counter;
+
+    explicit throw_on_copy_undo(int& c) noexcept : counter(&c) {}
+    throw_on_copy_undo(throw_on_copy_undo const&)
+    {
+        throw std::runtime_error("throw_on_copy_undo copy");
+    }
+
+    void operator() () const noexcept
+    {
+        ++(*counter);
+    }
+};
+
+void check_normal()
+{
+    std::vector< int > log;
+    {
+        boost::scope::transaction_scope<> tx;
+        BOOST_TEST(tx.empty());
+        tx.push_undo(undo_step{ &log, 1 });
+        tx.push_undo(undo_step{ &log, 2 });
+        BOOST_TEST_EQ(tx.size(), 2u);
+    }
+    BOOST_TEST(log.empty());
+
+    {
+        boost::scope::transaction_scope<> tx;
+        tx.push_undo(undo_step{ &log, 1 });
+        tx.commit();
+        BOOST_TEST(tx.empty());
+    }
+    BOOST_TEST(log.empty());
+}
+
+void check_throw()
+{
+    std::vector< int > log;
+    try
+    {
+        boost::scope::transaction_scope<> tx;
+        tx.push_undo(undo_step{ &log, 1 });
+        tx.push_undo(undo_step{ &log, 2 });
+        tx.emplace_undo< undo_step >(undo_step{ &log, 3 });
+        throw std::runtime_error("error");
+    }
+    catch (...) {}
+
+    BOOST_TEST_EQ(log.size(), 3u);
+    if (log.size() == 3u)
+    {
+        BOOST_TEST_EQ(log[0], 3);
+        BOOST_TEST_EQ(log[1], 2);
+        BOOST_TEST_EQ(log[2], 1);
+    }
+
+    log.clear();
+    try
+    {
+        boost::scope::transaction_scope<> tx;
+        tx.push_undo(undo_step{ &log, 1 });
+        tx.commit();
+        tx.push_undo(undo_step{ &log, 2 });
+        throw std::runtime_error("error");
+    }
+    catch (...) {}
+
+    BOOST_TEST_EQ(log.size(), 1u);
+    if (log.size() == 1u)
+    {
+        BOOST_TEST_EQ(log[0], 2);
+    }
+}
+
+void check_rollback()
+{
+    std::vector< int > log;
+    {
+        boost::scope::transaction_scope<> tx;
+        tx.push_undo(undo_step{ &log, 1 });
+        tx.push_undo(undo_step{ &log, 2 });
+        tx.rollback();
+        BOOST_TEST(tx.empty());
+        BOOST_TEST_EQ(log.size(), 2u);
+        tx.push_undo(undo_step{ &log, 3 });
+    }
+    BOOST_TEST_EQ(log.size(), 2u);
+    if (log.size() == 2u)
+    {
+        BOOST_TEST_EQ(log[0], 2);
+        BOOST_TEST_EQ(log[1], 1);
+    }
+}
+
+void check_overflow()
+{
+    // Use a small inline buffer to force allocating overflow chunks
+    int n = 0;
+    try
+    {
+        boost::scope::transaction_scope< boost::scope::exception_checker, 64u > tx;
+        for (int i = 0; i < 1000; ++i)
+            tx.push_undo(counted_undo(n));
+        BOOST_TEST_EQ(tx.size(), 1000u);
+        BOOST_TEST_EQ(counted_undo::live, 1000);
+        throw std::runtime_error("error");
+    }
+    catch (...) {}
+
+    BOOST_TEST_EQ(n, 1000);
+    BOOST_TEST_EQ(counted_undo::live, 0);
+
+    n = 0;
+    {
+        boost::scope::transaction_scope< boost::scope::exception_checker, 0u > tx;
+        for (int i = 0; i < 1000; ++i)
+            tx.push_undo(counted_undo(n));
+        std::string big(100u, 'x');
+        tx.push_undo([big, &n]() { n += static_cast< int >(big.size()); });
+        tx.commit();
+        BOOST_TEST_EQ(counted_undo::live, 0);
+        tx.push_undo(counted_undo(n));
+    }
+    BOOST_TEST_EQ(n, 0);
+    BOOST_TEST_EQ(counted_undo::live, 0);
+}
+
+void check_push_failure()
+{
+    int n = 0, m = 0;
+    try
+    {
+        boost::scope::transaction_scope<> tx;
+        tx.push_undo(counted_undo(m));
+        throw_on_copy_undo undo(n);
+        tx.push_undo(undo);
+    }
+    catch (...) {}
+
+    // The undo action that failed to be added is invoked immediately, then the log is rolled back
+    BOOST_TEST_EQ(n, 1);
+    BOOST_TEST_EQ(m, 1);
+    BOOST_TEST_EQ(counted_undo::live, 0);
+}
+
+void check_emplace_failure()
+{
+    int n = 0;
+    {
+        boost::scope::transaction_scope< boost::scope::exception_checker, 64u > tx;
+        throw_on_copy_undo undo(n);
+        for (int i = 0; i < 100; ++i)
+        {
+            try
+            {
+                tx.emplace_undo< throw_on_copy_undo >(undo);
+            }
+            catch (...) {}
+        }
+        BOOST_TEST(tx.empty());
+
+        // Failed constructions must not consume log storage, so the record still fits in the inline buffer
+        counted_undo& rec = tx.emplace_undo< counted_undo >(n);
+        const unsigned char* p = reinterpret_cast< const unsigned char* >(&rec);
+        const unsigned char* tx_begin = reinterpret_cast< const unsigned char* >(&tx);
+        BOOST_TEST(p >= tx_begin && p < tx_begin + sizeof(tx));
+        BOOST_TEST_EQ(tx.size(), 1u);
+        tx.rollback();
+    }
+    BOOST_TEST_EQ(n, 1);
+    BOOST_TEST_EQ(counted_undo::live, 0);
+}
+
+void check_cond()
+{
+    std::vector< int > log;
+    {
+        int err = 0;
+        boost::scope::transaction_scope< boost::scope::error_code_checker< int > > tx(boost::scope::check_error_code(err));
+        tx.push_undo(undo_step{ &log, 1 });
+        tx.push_undo(undo_step{ &log, 2 });
+        err = -1;
+    }
+    BOOST_TEST_EQ(log.size(), 2u);
+    if (log.size() == 2u)
+    {
+        BOOST_TEST_EQ(log[0], 2);
+        BOOST_TEST_EQ(log[1], 1);
+    }
+
+    log.clear();
+    {
+        int err = 0;
+        boost::scope::transaction_scope< boost::scope::error_code_checker< int > > tx(boost::scope::check_error_code(err));
+        tx.push_undo(undo_step{ &log, 1 });
+    }
+    BOOST_TEST(log.empty());
+}
+
+int main()
+{
+    BOOST_TEST(!std::is_copy_constructible< boost::scope::transaction_scope<> >::value);
+    BOOST_TEST(!std::is_move_constructible< boost::scope::transaction_scope<> >::value);
+
+    check_normal();
+    check_throw();
+    check_rollback();
+    check_overflow();
+    check_push_failure();
+    check_emplace_failure();
+    check_cond();
+
+    return boost::report_errors();
+}
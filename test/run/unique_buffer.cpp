@@ -0,0 +1,178 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   unique_buffer.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c unique_buffer and sized deleters.
+ */
+
+#define BOOST_ENABLE_ASSERT_HANDLER
+
+#include <boost/scope/unique_buffer.hpp>
+#include <boost/scope/sized_deleter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+unsigned int g_assertion_failures = 0u;
+
+namespace boost {
+
+void assertion_failed(char const*, char const*, char const*, long)
+{
+    ++g_assertion_failures;
+}
+
+void assertion_failed_msg(char const*, char const*, char const*, char const*, long)
+{
+    ++g_assertion_failures;
+}
+
+} // namespace boost
+
+void check_sized_deleter()
+{
+    {
+        constexpr boost::scope::sized_deleter del;
+        BOOST_TEST_EQ(del.size(), 0u);
+        BOOST_TEST_GE(del.alignment(), alignof(std::max_align_t));
+    }
+    {
+        boost::scope::sized_deleter del(100u, 64u);
+        BOOST_TEST_EQ(del.size(), 100u);
+        BOOST_TEST_EQ(del.alignment(), 64u);
+    }
+    {
+        const std::size_t size = static_cast< std::size_t >(1u) << (sizeof(std::size_t) * 8u - 9u);
+        boost::scope::sized_deleter del(size, 4096u);
+        BOOST_TEST_EQ(del.size(), size);
+        BOOST_TEST_EQ(del.alignment(), 4096u);
+    }
+    {
+        boost::scope::sized_free_deleter del(10u);
+        BOOST_TEST_EQ(del.size(), 10u);
+        BOOST_TEST_EQ(del.alignment(), alignof(std::max_align_t));
+    }
+
+    if (sizeof(std::size_t) >= 8u)
+    {
+        BOOST_TEST_EQ(sizeof(boost::scope::sized_deleter), sizeof(std::size_t));
+        BOOST_TEST_EQ(sizeof(boost::scope::sized_free_deleter), sizeof(std::size_t));
+
+        // Sizes that do not fit in the packed representation are detected
+        const std::size_t max_size = (static_cast< std::size_t >(1u) << (sizeof(std::size_t) * 8u - 8u)) - 1u;
+        boost::scope::sized_deleter del1(max_size);
+        BOOST_TEST_EQ(del1.size(), max_size);
+        BOOST_TEST_EQ(g_assertion_failures, 0u);
+        boost::scope::sized_free_deleter del2(max_size + 1u);
+        static_cast< void >(del2);
+        BOOST_TEST_EQ(g_assertion_failures, 1u);
+    }
+}
+
+void check_unique_buffer()
+{
+    {
+        boost::scope::unique_buffer buf;
+        BOOST_TEST(!buf.allocated());
+        BOOST_TEST(buf.get() == nullptr);
+    }
+    {
+        boost::scope::unique_buffer buf = boost::scope::make_unique_buffer(1000u);
+        BOOST_TEST(buf.allocated());
+        BOOST_TEST(buf.get() != nullptr);
+        BOOST_TEST_EQ(buf.get_deleter().size(), 1000u);
+        std::memset(buf.get(), 0, 1000u);
+
+        boost::scope::unique_buffer buf2 = std::move(buf);
+        BOOST_TEST(!buf.allocated());
+        BOOST_TEST(buf2.allocated());
+        BOOST_TEST_EQ(buf2.get_deleter().size(), 1000u);
+
+        buf2.reset();
+        BOOST_TEST(!buf2.allocated());
+    }
+#if defined(__cpp_aligned_new) && __cpp_aligned_new >= 201606l
+    {
+        boost::scope::unique_buffer buf = boost::scope::make_unique_buffer(256u, 256u);
+        BOOST_TEST(buf.allocated());
+        BOOST_TEST_EQ(reinterpret_cast< std::uintptr_t >(buf.get()) & 255u, 0u);
+        BOOST_TEST_EQ(buf.get_deleter().alignment(), 256u);
+    }
+#endif
+    {
+        boost::scope::unique_buffer buf(::operator new(10u), boost::scope::sized_deleter(10u));
+        BOOST_TEST(buf.allocated());
+    }
+}
+
+template< typename T, typename R, typename = decltype(std::declval< T& >().reset(std::declval< R >())) >
+std::true_type check_resettable(int);
+template< typename T, typename R >
+std::false_type check_resettable(...);
+
+void check_unique_buffer_reset()
+{
+    // Replacing the buffer without replacing the deleter would free it with a wrong size
+    BOOST_TEST(!(decltype(check_resettable< boost::scope::unique_buffer, void* >(0))::value));
+    BOOST_TEST(!(decltype(check_resettable< boost::scope::unique_malloc_buffer, void* >(0))::value));
+
+    boost::scope::unique_buffer buf = boost::scope::make_unique_buffer(16u);
+    buf.reset(::operator new(1000u), boost::scope::sized_deleter(1000u));
+    BOOST_TEST(buf.allocated());
+    BOOST_TEST_EQ(buf.get_deleter().size(), 1000u);
+    std::memset(buf.get(), 0, 1000u);
+
+    buf.reset();
+    BOOST_TEST(!buf.allocated());
+    buf.reset(::operator new(32u), boost::scope::sized_deleter(32u));
+    BOOST_TEST(buf.allocated());
+    BOOST_TEST_EQ(buf.get_deleter().size(), 32u);
+
+    boost::scope::unique_malloc_buffer mbuf(std::malloc(8u), boost::scope::sized_free_deleter(8u));
+    mbuf.reset(std::malloc(128u), boost::scope::sized_free_deleter(128u));
+    BOOST_TEST_EQ(mbuf.get_deleter().size(), 128u);
+}
+
+void check_unique_malloc_buffer()
+{
+    {
+        boost::scope::unique_malloc_buffer buf(std::malloc(64u), boost::scope::sized_free_deleter(64u));
+        BOOST_TEST(buf.allocated());
+        std::memset(buf.get(), 0, 64u);
+    }
+    {
+        boost::scope::unique_malloc_buffer buf(std::malloc(64u), boost::scope::sized_free_deleter(64u));
+        void* p = buf.get();
+        buf.release();
+        BOOST_TEST(!buf.allocated());
+        std::free(p);
+    }
+
+    if (sizeof(void*) >= 8u)
+    {
+        BOOST_TEST_EQ(sizeof(boost::scope::unique_buffer), 2u * sizeof(void*));
+        BOOST_TEST_EQ(sizeof(boost::scope::unique_malloc_buffer), 2u * sizeof(void*));
+    }
+}
+
+int main()
+{
+    check_sized_deleter();
+    check_unique_buffer();
+    check_unique_buffer_reset();
+    check_unique_malloc_buffer();
+
+    return boost::report_errors();
+}
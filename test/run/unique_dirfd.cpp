@@ -0,0 +1,137 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   unique_dirfd.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c unique_dirfd and directory-relative file system operations.
+ */
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_WINDOWS)
+
+#include <boost/scope/unique_dirfd.hpp>
+#include <boost/scope/scope_exit.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+struct remove_dir
+{
+    std::string const* m_path;
+
+    explicit remove_dir(std::string const& path) noexcept :
+        m_path(&path)
+    {
+    }
+
+    void operator()() const noexcept
+    {
+        ::rmdir(m_path->c_str());
+    }
+};
+
+void check_dir_ops(std::string const& base_path)
+{
+    std::error_code ec;
+    boost::scope::unique_dirfd base = boost::scope::open_dir(base_path.c_str(), ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(base.allocated());
+    BOOST_TEST((::fcntl(base.get(), F_GETFD) & FD_CLOEXEC) != 0);
+
+    boost::scope::mkdir_at(base, "sub", 0700, ec);
+    BOOST_TEST(!ec);
+
+    boost::scope::mkdir_at(base, "sub", 0700, ec);
+    BOOST_TEST(ec == std::errc::file_exists);
+
+    boost::scope::unique_dirfd sub = boost::scope::open_dir_at(base, "sub", ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(sub.allocated());
+
+    {
+        boost::scope::unique_fd file = boost::scope::open_at(sub, "file1", O_WRONLY | O_CREAT | O_EXCL, 0600, ec);
+        BOOST_TEST(!ec);
+        BOOST_TEST(file.allocated());
+        BOOST_TEST((::fcntl(file.get(), F_GETFD) & FD_CLOEXEC) != 0);
+        const char data[] = "data";
+        BOOST_TEST_EQ(::write(file.get(), data, 4u), static_cast< ssize_t >(4));
+    }
+
+    struct stat st = {};
+    boost::scope::stat_at(sub, "file1", st, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST_EQ(st.st_size, static_cast< off_t >(4));
+    BOOST_TEST(S_ISREG(st.st_mode));
+
+    boost::scope::stat_at(base, "sub/file1", st, AT_SYMLINK_NOFOLLOW, ec);
+    BOOST_TEST(!ec);
+
+    // Opening a regular file as a directory fails
+    boost::scope::unique_dirfd not_dir = boost::scope::open_dir_at(sub, "file1", ec);
+    BOOST_TEST(!!ec);
+    BOOST_TEST(!not_dir.allocated());
+
+    boost::scope::rename_at(sub, "file1", base, "file2", ec);
+    BOOST_TEST(!ec);
+
+    boost::scope::stat_at(sub, "file1", st, ec);
+    BOOST_TEST(ec == std::errc::no_such_file_or_directory);
+
+    boost::scope::unique_fd file = boost::scope::open_at(base, "file2", O_RDONLY, ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(file.allocated());
+
+    boost::scope::unlink_at(base, "file2", ec);
+    BOOST_TEST(!ec);
+
+    boost::scope::unlink_at(base, "file2", ec);
+    BOOST_TEST(ec == std::errc::no_such_file_or_directory);
+
+    boost::scope::unlink_at(base, "sub", AT_REMOVEDIR, ec);
+    BOOST_TEST(!ec);
+
+    boost::scope::unique_dirfd missing = boost::scope::open_dir("/nonexistent/boost_scope_test_dir", ec);
+    BOOST_TEST(ec == std::errc::no_such_file_or_directory);
+    BOOST_TEST(!missing.allocated());
+}
+
+int main()
+{
+    const char* tmp_dir = std::getenv("TMPDIR");
+    std::string base_path = (tmp_dir && *tmp_dir) ? tmp_dir : "/tmp";
+    base_path += "/boost_scope_dirfd_XXXXXX";
+    if (::mkdtemp(&base_path[0]) != nullptr)
+    {
+        boost::scope::scope_exit< remove_dir > cleanup{ remove_dir(base_path) };
+        check_dir_ops(base_path);
+    }
+    else
+    {
+        BOOST_ERROR("Failed to create a temporary directory");
+    }
+
+    return boost::report_errors();
+}
+
+#else // !defined(BOOST_WINDOWS)
+
+int main()
+{
+    return 0;
+}
+
+#endif // !defined(BOOST_WINDOWS)
@@ -0,0 +1,195 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   unique_memfd_buffer.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c unique_memfd_buffer.
+ */
+
+#include <boost/config.hpp>
+
+#if defined(__linux__)
+
+#include <boost/scope/unique_memfd_buffer.hpp>
+#include <boost/scope/fd_factories.hpp>
+#include <boost/scope/unique_fd.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <system_error>
+
+const std::size_t buffer_size = 8192u;
+
+bool memfd_supported(std::error_code const& ec)
+{
+    return ec != std::errc::function_not_supported && ec != std::errc::invalid_argument;
+}
+
+void check_create_and_seal()
+{
+    std::error_code ec;
+    boost::scope::unique_memfd_buffer buf = boost::scope::unique_memfd_buffer::create("test", buffer_size, ec);
+    if (!memfd_supported(ec))
+        return;
+
+    BOOST_TEST(!ec);
+    BOOST_TEST(!buf.empty());
+    BOOST_TEST(!!buf);
+    BOOST_TEST(buf.data() != nullptr);
+    BOOST_TEST_EQ(buf.size(), buffer_size);
+    BOOST_TEST(buf.writable());
+    BOOST_TEST(!buf.sealed());
+
+    std::memset(buf.data(), 0x5A, buf.size());
+
+    buf.seal(ec);
+    BOOST_TEST(!ec);
+    BOOST_TEST(buf.data() != nullptr);
+    BOOST_TEST_EQ(buf.size(), buffer_size);
+    BOOST_TEST(!buf.writable());
+    BOOST_TEST(buf.sealed());
+
+    const unsigned char* p = static_cast< const unsigned char* >(buf.data());
+    BOOST_TEST_EQ(p[0], 0x5A);
+    BOOST_TEST_EQ(p[buffer_size - 1u], 0x5A);
+
+    // Modifying the sealed file must fail
+    const unsigned char byte = 0u;
+    BOOST_TEST_LT(::pwrite(buf.fd().get(), &byte, 1u, 0), 0);
+    BOOST_TEST_NE(::ftruncate(buf.fd().get(), 0), 0);
+    BOOST_TEST_NE(::ftruncate(buf.fd().get(), static_cast< off_t >(buffer_size * 2u)), 0);
+
+    // Map the file read-only, as a consumer would
+    boost::scope::unique_fd consumer_fd = boost::scope::dup_fd(buf.fd().get(), ec);
+    BOOST_TEST(!ec);
+    boost::scope::unique_memfd_buffer consumer = boost::scope::unique_memfd_buffer::map(std::move(consumer_fd), ec, boost::scope::memfd_buffer_options::populate);
+    BOOST_TEST(!ec);
+    BOOST_TEST(!consumer_fd.allocated());
+    BOOST_TEST(consumer.data() != nullptr);
+    BOOST_TEST(consumer.data() != buf.data());
+    BOOST_TEST_EQ(consumer.size(), buffer_size);
+    BOOST_TEST(!consumer.writable());
+    BOOST_TEST(consumer.sealed());
+    BOOST_TEST_EQ(std::memcmp(consumer.data(), buf.data(), buffer_size), 0);
+}
+
+void check_move()
+{
+    std::error_code ec;
+    boost::scope::unique_memfd_buffer buf1 = boost::scope::unique_memfd_buffer::create("test", buffer_size, ec, boost::scope::memfd_buffer_options::populate);
+    if (!memfd_supported(ec))
+        return;
+
+    BOOST_TEST(!ec);
+    void* data = buf1.data();
+    const int fd = buf1.fd().get();
+
+    boost::scope::unique_memfd_buffer buf2(std::move(buf1));
+    BOOST_TEST(buf1.empty());
+    BOOST_TEST(buf1.data() == nullptr);
+    BOOST_TEST_EQ(buf1.size(), 0u);
+    BOOST_TEST(buf2.data() == data);
+    BOOST_TEST_EQ(buf2.fd().get(), fd);
+    BOOST_TEST_EQ(buf2.size(), buffer_size);
+    BOOST_TEST(buf2.writable());
+
+    boost::scope::unique_memfd_buffer buf3;
+    BOOST_TEST(buf3.empty());
+    buf3 = std::move(buf2);
+    BOOST_TEST(buf2.empty());
+    BOOST_TEST(buf3.data() == data);
+    BOOST_TEST_EQ(buf3.fd().get(), fd);
+
+    buf3.reset();
+    BOOST_TEST(buf3.empty());
+    BOOST_TEST(buf3.data() == nullptr);
+    BOOST_TEST_EQ(buf3.size(), 0u);
+}
+
+void check_errors()
+{
+    std::error_code ec;
+    boost::scope::unique_memfd_buffer buf = boost::scope::unique_memfd_buffer::map(boost::scope::unique_fd(), ec);
+    BOOST_TEST(!!ec);
+    BOOST_TEST(buf.empty());
+    BOOST_TEST(buf.data() == nullptr);
+
+    // Zero size is rejected
+    buf = boost::scope::unique_memfd_buffer::create("test", 0u, ec);
+    BOOST_TEST(ec == std::errc::invalid_argument);
+    BOOST_TEST(buf.empty());
+
+    // Mapping an empty file fails
+    boost::scope::unique_fd fd = boost::scope::memfd_fd("test", 0u, ec);
+    if (!memfd_supported(ec))
+        return;
+
+    BOOST_TEST(!ec);
+    buf = boost::scope::unique_memfd_buffer::map(std::move(fd), ec, boost::scope::memfd_buffer_options::allow_unsealed);
+    BOOST_TEST(!!ec);
+    BOOST_TEST(buf.empty());
+}
+
+void check_map_unsealed()
+{
+    std::error_code ec;
+    boost::scope::unique_memfd_buffer producer = boost::scope::unique_memfd_buffer::create("test", buffer_size, ec);
+    if (!memfd_supported(ec))
+        return;
+
+    BOOST_TEST(!ec);
+
+    // Mapping an unsealed file is not permitted by default
+    boost::scope::unique_fd fd = boost::scope::dup_fd(producer.fd().get(), ec);
+    BOOST_TEST(!ec);
+    boost::scope::unique_memfd_buffer consumer = boost::scope::unique_memfd_buffer::map(std::move(fd), ec);
+    BOOST_TEST(ec == std::errc::operation_not_permitted);
+    BOOST_TEST(consumer.empty());
+
+    // Unless explicitly allowed
+    fd = boost::scope::dup_fd(producer.fd().get(), ec);
+    BOOST_TEST(!ec);
+    consumer = boost::scope::unique_memfd_buffer::map(std::move(fd), ec, boost::scope::memfd_buffer_options::allow_unsealed);
+    BOOST_TEST(!ec);
+    BOOST_TEST(!consumer.empty());
+    BOOST_TEST_EQ(consumer.size(), buffer_size);
+    BOOST_TEST(!consumer.writable());
+    BOOST_TEST(!consumer.sealed());
+
+    // A file with only some of the required seals is not permitted either
+    BOOST_TEST_EQ(::fcntl(producer.fd().get(), F_ADD_SEALS, F_SEAL_GROW), 0);
+    fd = boost::scope::dup_fd(producer.fd().get(), ec);
+    BOOST_TEST(!ec);
+    consumer = boost::scope::unique_memfd_buffer::map(std::move(fd), ec);
+    BOOST_TEST(ec == std::errc::operation_not_permitted);
+    BOOST_TEST(consumer.empty());
+}
+
+int main()
+{
+    check_create_and_seal();
+    check_move();
+    check_errors();
+    check_map_unsealed();
+
+    return boost::report_errors();
+}
+
+#else // defined(__linux__)
+
+int main()
+{
+    return 0;
+}
+
+#endif // defined(__linux__)
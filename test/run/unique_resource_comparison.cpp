@@ -0,0 +1,172 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   unique_resource_comparison.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c unique_resource comparison and hashing.
+ */
+
+#include <boost/scope/unique_resource.hpp>
+#include <boost/scope/detail/type_traits/is_invocable.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <unordered_set>
+#include <set>
+#if defined(BOOST_SCOPE_DETAIL_HAS_THREE_WAY_COMPARISON)
+#include <compare>
+#endif
+
+struct empty_int_deleter
+{
+    void operator() (int) const noexcept
+    {
+    }
+};
+
+struct int_resource_traits
+{
+    static int make_default() noexcept
+    {
+        return -1;
+    }
+
+    static bool is_allocated(int res) noexcept
+    {
+        return res >= 0;
+    }
+};
+
+using unique_int = boost::scope::unique_resource< int, empty_int_deleter, int_resource_traits >;
+
+struct non_comparable
+{
+    int value;
+};
+
+struct non_comparable_deleter
+{
+    void operator() (non_comparable const&) const noexcept
+    {
+    }
+};
+
+template< typename T, typename = decltype(std::declval< T const& >() == std::declval< T const& >()) >
+std::true_type check_equality_comparable(int);
+template< typename T >
+std::false_type check_equality_comparable(...);
+
+template< typename T, typename = decltype(std::declval< T const& >() < std::declval< T const& >()) >
+std::true_type check_less_than_comparable(int);
+template< typename T >
+std::false_type check_less_than_comparable(...);
+
+void check_comparison()
+{
+    BOOST_TEST((decltype(check_equality_comparable< unique_int >(0))::value));
+    BOOST_TEST((decltype(check_less_than_comparable< unique_int >(0))::value));
+    using unique_non_comparable = boost::scope::unique_resource< non_comparable, non_comparable_deleter >;
+    BOOST_TEST(!(decltype(check_equality_comparable< unique_non_comparable >(0))::value));
+    BOOST_TEST(!(decltype(check_less_than_comparable< unique_non_comparable >(0))::value));
+
+    unique_int ur1(1), ur2(2), ur3(1);
+    BOOST_TEST(ur1 == ur3);
+    BOOST_TEST(!(ur1 == ur2));
+    BOOST_TEST(ur1 != ur2);
+    BOOST_TEST(!(ur1 != ur3));
+    BOOST_TEST(ur1 < ur2);
+    BOOST_TEST(!(ur2 < ur1));
+    BOOST_TEST(ur2 > ur1);
+    BOOST_TEST(ur1 <= ur3);
+    BOOST_TEST(ur1 <= ur2);
+    BOOST_TEST(!(ur2 <= ur1));
+    BOOST_TEST(ur1 >= ur3);
+    BOOST_TEST(ur2 >= ur1);
+    BOOST_TEST(noexcept(ur1 == ur2));
+    BOOST_TEST(noexcept(ur1 < ur2));
+
+    // Unallocated resources compare equal to each other
+    unique_int ur4, ur5;
+    BOOST_TEST(ur4 == ur5);
+    BOOST_TEST(ur4 < ur1);
+
+#if defined(BOOST_SCOPE_DETAIL_HAS_THREE_WAY_COMPARISON)
+    BOOST_TEST((ur1 <=> ur3) == 0);
+    BOOST_TEST((ur1 <=> ur2) < 0);
+    BOOST_TEST((ur2 <=> ur1) > 0);
+    BOOST_TEST((std::is_same< decltype(ur1 <=> ur2), std::strong_ordering >::value));
+#endif
+
+    std::set< unique_int > ordered;
+    ordered.insert(unique_int(3));
+    ordered.insert(unique_int(1));
+    ordered.insert(unique_int(2));
+    BOOST_TEST_EQ(ordered.size(), 3u);
+    BOOST_TEST_EQ(ordered.begin()->get(), 1);
+}
+
+void check_hash()
+{
+    unique_int ur(10);
+    BOOST_TEST_EQ(std::hash< unique_int >()(ur), std::hash< int >()(10));
+    BOOST_TEST_EQ(boost::scope::unique_resource_hash()(ur), std::hash< int >()(10));
+    BOOST_TEST_EQ(boost::scope::unique_resource_hash()(10), std::hash< int >()(10));
+
+    boost::scope::unique_resource_equal eq;
+    BOOST_TEST(eq(ur, 10));
+    BOOST_TEST(eq(10, ur));
+    BOOST_TEST(eq(ur, unique_int(10)));
+    BOOST_TEST(!eq(ur, 11));
+    BOOST_TEST(!eq(11, ur));
+    BOOST_TEST(noexcept(eq(ur, 10)));
+
+    std::unordered_set< unique_int > set;
+    set.insert(unique_int(1));
+    set.insert(unique_int(2));
+    BOOST_TEST_EQ(set.size(), 2u);
+    BOOST_TEST(set.find(unique_int(1)) != set.end());
+
+    // Hashing is disabled for resource types that are not hashable
+    using unique_non_comparable = boost::scope::unique_resource< non_comparable, non_comparable_deleter >;
+    BOOST_TEST(!std::is_default_constructible< std::hash< unique_non_comparable > >::value);
+    BOOST_TEST(!(boost::scope::detail::is_invocable< boost::scope::unique_resource_hash const&, unique_non_comparable const& >::value));
+    BOOST_TEST(!(boost::scope::detail::is_invocable< boost::scope::unique_resource_hash const&, non_comparable const& >::value));
+    BOOST_TEST((boost::scope::detail::is_invocable< boost::scope::unique_resource_hash const&, unique_int const& >::value));
+}
+
+void check_heterogeneous_lookup()
+{
+    using set_type = std::unordered_set< unique_int, boost::scope::unique_resource_hash, boost::scope::unique_resource_equal >;
+    set_type set;
+    for (int i = 0; i < 10; ++i)
+        set.insert(unique_int(i));
+
+    BOOST_TEST(set.find(unique_int(5)) != set.end());
+    BOOST_TEST(set.find(unique_int(15)) == set.end());
+
+#if defined(__cpp_lib_generic_unordered_lookup) && (__cpp_lib_generic_unordered_lookup >= 201811l)
+    set_type::iterator it = set.find(5);
+    BOOST_TEST(it != set.end());
+    if (it != set.end())
+        BOOST_TEST_EQ(it->get(), 5);
+    BOOST_TEST(set.find(15) == set.end());
+    BOOST_TEST_EQ(set.count(3), 1u);
+#endif
+}
+
+int main()
+{
+    check_comparison();
+    check_hash();
+    check_heterogeneous_lookup();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,101 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   unique_resource_fast_teardown.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c unique_resource fast teardown mode.
+ */
+
+#include <boost/scope/unique_resource.hpp>
+#include <boost/scope/fast_teardown.hpp>
+#include <boost/scope/resource_usage_counters.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+int g_deleted = 0;
+
+struct counting_deleter
+{
+    void operator() (int) const noexcept
+    {
+        ++g_deleted;
+    }
+};
+
+struct essential_traits
+{
+    static int make_default() noexcept
+    {
+        return -1;
+    }
+
+    static bool is_allocated(int res) noexcept
+    {
+        return res >= 0;
+    }
+};
+
+struct reclaimable_traits :
+    public essential_traits
+{
+    static constexpr bool skip_deleter_on_teardown = true;
+};
+
+struct instrumented_reclaimable_traits :
+    public reclaimable_traits
+{
+    using instrumentation = boost::scope::resource_usage_counters< instrumented_reclaimable_traits >;
+};
+
+using essential_resource = boost::scope::unique_resource< int, counting_deleter, essential_traits >;
+using reclaimable_resource = boost::scope::unique_resource< int, counting_deleter, reclaimable_traits >;
+using instrumented_resource = boost::scope::unique_resource< int, counting_deleter, instrumented_reclaimable_traits >;
+using untraited_resource = boost::scope::unique_resource< int, counting_deleter >;
+
+void check_deleters_called(int expected)
+{
+    g_deleted = 0;
+    {
+        essential_resource ur1(1);
+        reclaimable_resource ur2(2);
+        untraited_resource ur3(3, counting_deleter());
+        reclaimable_resource ur4;
+    }
+    BOOST_TEST_EQ(g_deleted, expected);
+
+    // Explicit reset always calls the deleter
+    g_deleted = 0;
+    {
+        reclaimable_resource ur(1);
+        ur.reset();
+        BOOST_TEST_EQ(g_deleted, 1);
+    }
+    BOOST_TEST_EQ(g_deleted, 1);
+}
+
+int main()
+{
+    BOOST_TEST(!boost::scope::is_fast_teardown_enabled());
+    check_deleters_called(3);
+
+    boost::scope::enable_fast_teardown();
+    BOOST_TEST(boost::scope::is_fast_teardown_enabled());
+    check_deleters_called(2);
+
+    // Instrumentation is notified that the resource was released without calling the deleter
+    g_deleted = 0;
+    {
+        instrumented_resource ur(1);
+    }
+    BOOST_TEST_EQ(g_deleted, 0);
+    boost::scope::resource_usage_snapshot snapshot = boost::scope::resource_usage_counters< instrumented_reclaimable_traits >::snapshot();
+    BOOST_TEST_EQ(snapshot.live, 0u);
+    BOOST_TEST_EQ(snapshot.released, 1u);
+
+    return boost::report_errors();
+}
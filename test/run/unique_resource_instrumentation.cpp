@@ -0,0 +1,280 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   unique_resource_instrumentation.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c unique_resource instrumentation.
+ */
+
+#include <boost/scope/unique_resource.hpp>
+#include <boost/scope/resource_usage_counters.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstdint>
+#include <utility>
+#include <thread>
+
+struct empty_int_deleter
+{
+    void operator() (int) const noexcept
+    {
+    }
+};
+
+int g_acquired = 0, g_released = 0, g_reset = 0, g_moved = 0, g_swapped = 0;
+// Store addresses as integers, as the owners are local objects that may be destroyed before the addresses are compared
+std::uintptr_t g_last_owner = 0u;
+std::uintptr_t g_last_from = 0u;
+
+inline std::uintptr_t to_address(const void* p) noexcept
+{
+    return reinterpret_cast< std::uintptr_t >(p);
+}
+
+struct counting_instrumentation
+{
+    static void on_acquire(const void* owner, int const&) noexcept
+    {
+        ++g_acquired;
+        g_last_owner = to_address(owner);
+    }
+
+    static void on_release(const void* owner, int const&) noexcept
+    {
+        ++g_released;
+        g_last_owner = to_address(owner);
+    }
+
+    static void on_reset(const void* owner, int const&) noexcept
+    {
+        ++g_reset;
+        g_last_owner = to_address(owner);
+    }
+
+    static void on_move(const void* from, const void* to, int const&) noexcept
+    {
+        ++g_moved;
+        g_last_from = to_address(from);
+        g_last_owner = to_address(to);
+    }
+
+    static void on_swap(const void* left, const void*) noexcept
+    {
+        ++g_swapped;
+        g_last_owner = to_address(left);
+    }
+};
+
+struct instrumented_int_traits
+{
+    using instrumentation = counting_instrumentation;
+
+    static int make_default() noexcept
+    {
+        return -1;
+    }
+
+    static bool is_allocated(int res) noexcept
+    {
+        return res >= 0;
+    }
+};
+
+void reset_counters()
+{
+    g_acquired = g_released = g_reset = g_moved = g_swapped = 0;
+    g_last_owner = g_last_from = 0u;
+}
+
+void check_events()
+{
+    using unique_int = boost::scope::unique_resource< int, empty_int_deleter, instrumented_int_traits >;
+
+    reset_counters();
+    {
+        unique_int ur;
+        BOOST_TEST(!ur.allocated());
+        unique_int ur2(-1);
+        BOOST_TEST(!ur2.allocated());
+    }
+    BOOST_TEST_EQ(g_acquired, 0);
+    BOOST_TEST_EQ(g_reset, 0);
+
+    reset_counters();
+    {
+        unique_int ur(10);
+        BOOST_TEST_EQ(g_acquired, 1);
+        BOOST_TEST_EQ(g_last_owner, to_address(&ur));
+    }
+    BOOST_TEST_EQ(g_reset, 1);
+
+    reset_counters();
+    {
+        unique_int ur(10);
+        ur.release();
+        BOOST_TEST_EQ(g_released, 1);
+        ur.release();
+        BOOST_TEST_EQ(g_released, 1);
+    }
+    BOOST_TEST_EQ(g_reset, 0);
+
+    reset_counters();
+    {
+        unique_int ur(10);
+        ur.reset(20);
+        BOOST_TEST_EQ(g_acquired, 2);
+        BOOST_TEST_EQ(g_reset, 1);
+        ur.reset();
+        BOOST_TEST_EQ(g_reset, 2);
+        ur.reset(-1);
+        BOOST_TEST_EQ(g_acquired, 2);
+    }
+    BOOST_TEST_EQ(g_reset, 2);
+
+    reset_counters();
+    {
+        unique_int ur1(10);
+        unique_int ur2 = std::move(ur1);
+        BOOST_TEST_EQ(g_moved, 1);
+        BOOST_TEST_EQ(g_last_from, to_address(&ur1));
+        BOOST_TEST_EQ(g_last_owner, to_address(&ur2));
+
+        unique_int ur3(20);
+        ur3 = std::move(ur2);
+        BOOST_TEST_EQ(g_moved, 2);
+        BOOST_TEST_EQ(g_reset, 1);
+        BOOST_TEST_EQ(g_last_from, to_address(&ur2));
+        BOOST_TEST_EQ(g_last_owner, to_address(&ur3));
+
+        unique_int ur4 = std::move(ur1);
+        BOOST_TEST_EQ(g_moved, 2);
+
+        ur4.swap(ur3);
+        BOOST_TEST_EQ(g_swapped, 1);
+        BOOST_TEST_EQ(g_last_owner, to_address(&ur4));
+    }
+    BOOST_TEST_EQ(g_acquired, 2);
+    BOOST_TEST_EQ(g_reset, 2);
+}
+
+struct counted_int_traits
+{
+    using instrumentation = boost::scope::resource_usage_counters< counted_int_traits >;
+
+    static int make_default() noexcept
+    {
+        return -1;
+    }
+
+    static bool is_allocated(int res) noexcept
+    {
+        return res >= 0;
+    }
+};
+
+int g_hook_calls = 0;
+
+void event_hook(boost::scope::resource_event, const void*)
+{
+    ++g_hook_calls;
+}
+
+void check_usage_counters()
+{
+    using counters = boost::scope::resource_usage_counters< counted_int_traits >;
+    using unique_int = boost::scope::unique_resource< int, empty_int_deleter, counted_int_traits >;
+
+    counters::clear();
+    {
+        unique_int ur1(1), ur2(2), ur3(3);
+        boost::scope::resource_usage_snapshot snap = counters::snapshot();
+        BOOST_TEST_EQ(snap.acquired, 3u);
+        BOOST_TEST_EQ(snap.live, 3u);
+        BOOST_TEST_EQ(snap.high_water_mark, 3u);
+
+        ur1.release();
+        ur2.reset();
+        unique_int ur4 = std::move(ur3);
+
+        snap = counters::snapshot();
+        BOOST_TEST_EQ(snap.released, 1u);
+        BOOST_TEST_EQ(snap.reset, 1u);
+        BOOST_TEST_EQ(snap.moved, 1u);
+        BOOST_TEST_EQ(snap.live, 1u);
+        BOOST_TEST_EQ(snap.high_water_mark, 3u);
+    }
+
+    boost::scope::resource_usage_snapshot snap = counters::snapshot();
+    BOOST_TEST_EQ(snap.reset, 2u);
+    BOOST_TEST_EQ(snap.live, 0u);
+
+    BOOST_TEST(counters::set_event_hook(&event_hook) == nullptr);
+    {
+        unique_int ur(1);
+        BOOST_TEST_EQ(g_hook_calls, 1);
+    }
+    BOOST_TEST_EQ(g_hook_calls, 2);
+    BOOST_TEST(counters::set_event_hook(nullptr) == &event_hook);
+    {
+        unique_int ur(1);
+    }
+    BOOST_TEST_EQ(g_hook_calls, 2);
+}
+
+void check_high_water_mark()
+{
+    using counters = boost::scope::resource_usage_counters< counted_int_traits >;
+    using unique_int = boost::scope::unique_resource< int, empty_int_deleter, counted_int_traits >;
+
+    counters::clear();
+
+    // Threads use different counter shards. The maximum must be computed over the total number of live resources,
+    // not summed over the shards.
+    for (int i = 0; i < 2; ++i)
+    {
+        std::thread th([]()
+        {
+            unique_int ur1(1), ur2(2);
+            BOOST_TEST_EQ(counters::snapshot().high_water_mark, 2u);
+        });
+        th.join();
+    }
+
+    boost::scope::resource_usage_snapshot snap = counters::snapshot();
+    BOOST_TEST_EQ(snap.acquired, 4u);
+    BOOST_TEST_EQ(snap.live, 0u);
+    BOOST_TEST_EQ(snap.high_water_mark, 2u);
+
+    {
+        unique_int ur1(1);
+        std::thread th([]()
+        {
+            unique_int ur2(2), ur3(3);
+            BOOST_TEST_EQ(counters::snapshot().live, 3u);
+        });
+        th.join();
+    }
+
+    // The high-water mark is sampled at snapshot time, peaks between snapshots are not reflected
+    {
+        unique_int ur1(1), ur2(2), ur3(3), ur4(4);
+    }
+
+    snap = counters::snapshot();
+    BOOST_TEST_EQ(snap.live, 0u);
+    BOOST_TEST_EQ(snap.high_water_mark, 3u);
+}
+
+int main()
+{
+    check_events();
+    check_usage_counters();
+    check_high_water_mark();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,154 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * https://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Copyright (c) 2024 Andrey Semashev
+ */
+/*!
+ * \file   unique_resource_leak_detector.cpp
+ * \author Andrey Semashev
+ *
+ * \brief  This file contains tests for \c resource_leak_detector.
+ */
+
+#include <boost/scope/unique_resource.hpp>
+#include <boost/scope/resource_leak_detector.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+struct empty_int_deleter
+{
+    void operator() (int) const noexcept
+    {
+    }
+};
+
+struct tracked_int_traits
+{
+    using instrumentation = boost::scope::resource_leak_detector< tracked_int_traits >;
+
+    static int make_default() noexcept
+    {
+        return -1;
+    }
+
+    static bool is_allocated(int res) noexcept
+    {
+        return res >= 0;
+    }
+};
+
+using detector = boost::scope::resource_leak_detector< tracked_int_traits >;
+using unique_int = boost::scope::unique_resource< int, empty_int_deleter, tracked_int_traits >;
+
+unique_int make_int(int value)
+{
+    return unique_int(value, boost::scope::resource_site::current());
+}
+
+void check_tracking()
+{
+    BOOST_TEST_EQ(detector::live_count(), 0u);
+    {
+        unique_int ur1(1);
+        BOOST_TEST_EQ(detector::live_count(), 1u);
+        unique_int ur2(-1);
+        BOOST_TEST_EQ(detector::live_count(), 1u);
+
+        unique_int ur3 = std::move(ur1);
+        BOOST_TEST_EQ(detector::live_count(), 1u);
+
+        ur2.swap(ur3);
+        BOOST_TEST_EQ(detector::live_count(), 1u);
+
+        ur3.reset(3);
+        BOOST_TEST_EQ(detector::live_count(), 2u);
+        ur3.release();
+        BOOST_TEST_EQ(detector::live_count(), 1u);
+
+        ur2 = unique_int(5);
+        BOOST_TEST_EQ(detector::live_count(), 1u);
+    }
+    BOOST_TEST_EQ(detector::live_count(), 0u);
+}
+
+void check_report()
+{
+    std::vector< unique_int > resources;
+    resources.reserve(8u);
+
+    const unsigned int line1 = __LINE__ + 2u;
+    for (int i = 0; i < 3; ++i)
+        resources.push_back(unique_int(i, boost::scope::resource_site::current()));
+
+    const unsigned int line2 = __LINE__ + 1u;
+    unique_int ur(10, empty_int_deleter(), boost::scope::resource_site::current());
+
+    unique_int ur2 = make_int(20);
+
+    // Resources acquired without a source location are reported with an unknown location
+    unique_int ur3(30);
+    unique_int ur4;
+    ur4.reset(40);
+
+    std::vector< boost::scope::resource_leak_record > records = detector::report();
+    BOOST_TEST_EQ(records.size(), 4u);
+    if (records.size() == 4u)
+    {
+        BOOST_TEST_EQ(records[0].count, 3u);
+        BOOST_TEST_EQ(records[1].count, 2u);
+        BOOST_TEST(!records[1].site.known());
+        BOOST_TEST_EQ(records[2].count, 1u);
+        BOOST_TEST_EQ(records[3].count, 1u);
+
+#if defined(BOOST_SCOPE_DETAIL_HAS_BUILTIN_SOURCE_LOCATION)
+        BOOST_TEST(records[0].site.known());
+        BOOST_TEST_EQ(records[0].site.line, line1);
+
+        // Resources constructed in the same file are ordered by line number
+        boost::scope::resource_site const& make_int_site = records[2].site.line < records[3].site.line ? records[2].site : records[3].site;
+        boost::scope::resource_site const& ur_site = records[2].site.line < records[3].site.line ? records[3].site : records[2].site;
+        BOOST_TEST_EQ(ur_site.line, line2);
+        BOOST_TEST_CSTR_EQ(make_int_site.function, "make_int");
+#else
+        (void)line1;
+        (void)line2;
+#endif
+    }
+
+    resources.clear();
+    ur3.reset();
+    ur4.reset();
+    records = detector::report();
+    BOOST_TEST_EQ(records.size(), 2u);
+
+    const unsigned int line3 = __LINE__ + 1u;
+    ur3.reset(50, boost::scope::resource_site::current());
+    records = detector::report();
+    BOOST_TEST_EQ(records.size(), 3u);
+#if defined(BOOST_SCOPE_DETAIL_HAS_BUILTIN_SOURCE_LOCATION)
+    bool reset_found = false;
+    for (std::size_t i = 0u; i < records.size(); ++i)
+        reset_found |= records[i].site.line == line3;
+    BOOST_TEST(reset_found);
+#else
+    (void)line3;
+#endif
+
+    auto ur5 = boost::scope::make_unique_resource_checked(60, -1, empty_int_deleter(), boost::scope::resource_site::current());
+    BOOST_TEST(ur5.allocated());
+    auto ur6 = boost::scope::make_unique_resource_checked(-1, -1, empty_int_deleter(), boost::scope::resource_site::current());
+    BOOST_TEST(!ur6.allocated());
+}
+
+int main()
+{
+    check_tracking();
+    check_report();
+    BOOST_TEST_EQ(detector::live_count(), 0u);
+
+    return boost::report_errors();
+}